@@ -18,8 +18,114 @@ from esphome.const import (
 # 
 CONF_POWER_RATIO = "power_ratio"
 CONF_BAUD_RATE = "baud_rate"
+CONF_DE_PIN = "de_pin"
 CONF_RX_BUFFER_SIZE = "rx_buffer_size"
 CONF_SIMULATE = "simulate"
+CONF_SIMULATE_INTERVAL = "simulate_interval"
+CONF_SIMULATE_SEED = "simulate_seed"
+CONF_SIMULATE_INJECT_FRAMES = "simulate_inject_frames"
+CONF_BURST_CYCLE = "burst_cycle"
+CONF_METER_ADDRESSES = "meter_addresses"
+CONF_REFRESH_INTERVALS = "refresh_intervals"
+CONF_DEADBANDS = "deadbands"
+CONF_PASSIVE_LISTEN = "passive_listen"
+CONF_FAST_BAUD_DISCOVERY = "fast_baud_discovery"
+CONF_MAX_RETRIES = "max_retries"
+CONF_TASK_STACK_SIZE = "task_stack_size"
+CONF_RX_TASK_STACK_SIZE = "rx_task_stack_size"
+CONF_TASK_PRIORITY = "task_priority"
+CONF_PIN_TO_CORE = "pin_to_core"
+CONF_STATS_INTERVAL = "stats_interval"
+CONF_ON_STATS = "on_stats"
+CONF_HEARTBEAT_INTERVAL = "heartbeat_interval"
+CONF_EVENT_DRAIN_BUDGET = "event_drain_budget"
+CONF_CHANNELS = "channels"
+CONF_REGISTERS = "registers"
+CONF_ON_VALUE = "on_value"
+CONF_ON_ACTION_RESULT = "on_action_result"
+CONF_ON_BURST_CAPTURE = "on_burst_capture"
+CONF_ONE_SHOT_MODE = "one_shot_mode"
+CONF_ONE_SHOT_READINGS = "one_shot_readings"
+CONF_ON_ONE_SHOT_COMPLETE = "on_one_shot_complete"
+CONF_FLIGHT_RECORDER_SIZE = "flight_recorder_size"
+CONF_DURATION = "duration"
+
+# Channel name -> compile-time define; declaring `channels:` in YAML compiles the
+# rest out of the binary (descriptor entries, parse branches, callbacks, triggers)
+CHANNEL_DEFINES = {
+    "active_power": "DLT645_USE_ACTIVE_POWER",
+    "energy_active": "DLT645_USE_ENERGY_ACTIVE",
+    "voltage_a": "DLT645_USE_VOLTAGE_A",
+    "current_a": "DLT645_USE_CURRENT_A",
+    "power_factor": "DLT645_USE_POWER_FACTOR",
+    "frequency": "DLT645_USE_FREQUENCY",
+    "energy_reverse": "DLT645_USE_ENERGY_REVERSE",
+    "datetime": "DLT645_USE_DATETIME",
+    "time_hms": "DLT645_USE_TIME_HMS",
+    "relay_status": "DLT645_USE_RELAY_STATUS",
+}
+
+# Channel name -> DLT645_REQUEST_TYPE value (see dlt645.h)
+REFRESH_INTERVAL_CHANNELS = {
+    "active_power": 0x02,
+    "energy_active": 0x03,
+    "voltage_a": 0x04,
+    "current_a": 0x05,
+    "power_factor": 0x06,
+    "frequency": 0x07,
+    "energy_reverse": 0x08,
+    "datetime": 0x09,
+    "time_hms": 0x0A,
+}
+
+
+def validate_channels(config):
+    """Cross-check triggers, refresh intervals and deadbands against the channel set."""
+    if CONF_CHANNELS not in config:
+        return config
+    channels = set(config[CONF_CHANNELS])
+    if "active_power" not in channels:
+        raise cv.Invalid(
+            "channels must include 'active_power': address discovery polls the power register"
+        )
+    trigger_channels = {
+        CONF_ON_ACTIVE_POWER: "active_power",
+        CONF_ON_WARNING_REVERSE_POWER: "active_power",
+        CONF_ON_ENERGY_ACTIVE: "energy_active",
+        CONF_ON_VOLTAGE_A: "voltage_a",
+        CONF_ON_CURRENT_A: "current_a",
+        CONF_ON_POWER_FACTOR: "power_factor",
+        CONF_ON_FREQUENCY: "frequency",
+        CONF_ON_ENERGY_REVERSE: "energy_reverse",
+        CONF_ON_DATETIME: "datetime",
+        CONF_ON_TIME_HMS: "time_hms",
+        CONF_ON_RELAY_STATUS: "relay_status",
+    }
+    for key, channel in trigger_channels.items():
+        if key in config and channel not in channels:
+            raise cv.Invalid(
+                "{} requires channel '{}' to be declared in channels".format(key, channel)
+            )
+    for name in config.get(CONF_REFRESH_INTERVALS, {}):
+        if name not in channels:
+            raise cv.Invalid(
+                "refresh_intervals entry '{}' is not in the declared channels".format(name)
+            )
+    if config.get(CONF_ONE_SHOT_MODE):
+        for name in config[CONF_ONE_SHOT_READINGS]:
+            if name not in channels:
+                raise cv.Invalid(
+                    "one_shot_readings entry '{}' is not in the declared channels".format(name)
+                )
+    return config
+
+
+def validate_meter_address(value):
+    """Validate a 12-digit decimal DL/T 645 meter address string."""
+    value = cv.string_strict(value)
+    if len(value) != 12 or not value.isdigit():
+        raise cv.Invalid("Meter address must be a 12-digit decimal string, got '{}'".format(value))
+    return value
 
 # DL/T 645-2007 
 CONF_ON_DEVICE_ADDRESS = "on_device_address"
@@ -78,6 +184,22 @@ TimeHmsTrigger = dlt645_component_ns.class_(
 RelayStatusTrigger = dlt645_component_ns.class_(
     "RelayStatusTrigger", automation.Trigger.template(cg.uint32, cg.uint32)
 )
+DLT645Stats = dlt645_component_ns.struct("DLT645Stats")
+StatsTrigger = dlt645_component_ns.class_(
+    "StatsTrigger", automation.Trigger.template(DLT645Stats)
+)
+ValueTrigger = dlt645_component_ns.class_(
+    "ValueTrigger", automation.Trigger.template(cg.uint32, cg.uint32, cg.float_)
+)
+ActionResultTrigger = dlt645_component_ns.class_(
+    "ActionResultTrigger", automation.Trigger.template(cg.uint32, cg.uint8, cg.uint8)
+)
+BurstCaptureTrigger = dlt645_component_ns.class_(
+    "BurstCaptureTrigger", automation.Trigger.template(cg.uint32)
+)
+OneShotCompleteTrigger = dlt645_component_ns.class_(
+    "OneShotCompleteTrigger", automation.Trigger.template(cg.uint32)
+)
 
 # DL/T 645-2007 Relay Control and DateTime Setting Actions
 RelayTripAction = dlt645_component_ns.class_("RelayTripAction", automation.Action)
@@ -85,6 +207,8 @@ RelayCloseAction = dlt645_component_ns.class_("RelayCloseAction", automation.Act
 SetDatetimeAction = dlt645_component_ns.class_("SetDatetimeAction", automation.Action)
 SetTimeAction = dlt645_component_ns.class_("SetTimeAction", automation.Action)
 BroadcastTimeSyncAction = dlt645_component_ns.class_("BroadcastTimeSyncAction", automation.Action)
+BurstCaptureAction = dlt645_component_ns.class_("BurstCaptureAction", automation.Action)
+DumpFlightRecorderAction = dlt645_component_ns.class_("DumpFlightRecorderAction", automation.Action)
 
 # Component configuration
 CONFIG_SCHEMA = cv.Schema(
@@ -93,10 +217,70 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(CONF_POWER_RATIO, default=10): cv.int_range(min=1, max=100),
         cv.Optional(CONF_TX_PIN, default=1): pins.internal_gpio_output_pin_number,
         cv.Optional(CONF_RX_PIN, default=2): pins.internal_gpio_input_pin_number,
+        # RS-485 DE/RE driver-enable line, driven by UART hardware half-duplex
+        # mode (released within a character time of the last stop bit)
+        cv.Optional(CONF_DE_PIN): pins.internal_gpio_output_pin_number,
         cv.Optional(CONF_BAUD_RATE, default=2400): cv.int_range(min=1200, max=9600),
         cv.Optional(CONF_RX_BUFFER_SIZE, default=256): cv.int_range(min=128, max=1024),
         cv.Optional(CONF_SIMULATE, default=False): cv.boolean,
-        
+        # Load generation: emission period, PRNG seed (replayable) and raw-frame
+        # injection through the real parser
+        cv.Optional(CONF_SIMULATE_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SIMULATE_SEED, default=0x645645): cv.hex_uint32_t,
+        cv.Optional(CONF_SIMULATE_INJECT_FRAMES, default=False): cv.boolean,
+        cv.Optional(CONF_BURST_CYCLE, default=False): cv.boolean,
+        # Declared channel set; unused channels are compiled out. Omit for all channels.
+        cv.Optional(CONF_CHANNELS): cv.ensure_list(cv.one_of(*CHANNEL_DEFINES, lower=True)),
+        # Generic register engine: extra DIs to poll beyond the built-in channels
+        # (three-phase blocks, demand, tariff energy). Block reads set count > 1.
+        cv.Optional(CONF_REGISTERS): cv.ensure_list(
+            cv.Schema(
+                {
+                    cv.Required("data_identifier"): cv.hex_uint32_t,
+                    cv.Required("name"): cv.string_strict,
+                    cv.Optional("length", default=2): cv.int_range(min=1, max=6),
+                    cv.Optional("decimal_places", default=1): cv.int_range(min=0, max=6),
+                    cv.Optional("signed", default=False): cv.boolean,
+                    cv.Optional("scale", default=1.0): cv.float_,
+                    cv.Optional("count", default=1): cv.int_range(min=1, max=8),
+                    cv.Optional("interval", default="5s"): cv.positive_time_period_milliseconds,
+                }
+            )
+        ),
+        cv.Optional(CONF_METER_ADDRESSES): cv.ensure_list(validate_meter_address),
+        cv.Optional(CONF_REFRESH_INTERVALS): cv.Schema(
+            {
+                cv.Optional(name): cv.positive_time_period_milliseconds
+                for name in REFRESH_INTERVAL_CHANNELS
+            }
+        ),
+        # Publish deadbands: callbacks are skipped while the value stays within the band
+        cv.Optional(CONF_DEADBANDS): cv.Schema(
+            {
+                cv.Optional("active_power"): cv.positive_float,  # W
+                cv.Optional("voltage_a"): cv.positive_float,  # V
+                cv.Optional("current_a"): cv.positive_float,  # A
+                cv.Optional("power_factor"): cv.positive_float,
+                cv.Optional("frequency"): cv.positive_float,  # Hz
+                cv.Optional("energy"): cv.positive_float,  # kWh (forward and reverse)
+            }
+        ),
+        cv.Optional(CONF_HEARTBEAT_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+        # Max events dispatched per loop() pass; the rest stay pending (0 = unlimited)
+        cv.Optional(CONF_EVENT_DRAIN_BUDGET, default=4): cv.int_range(min=0, max=16),
+        cv.Optional(CONF_PASSIVE_LISTEN, default=False): cv.boolean,
+        cv.Optional(CONF_FAST_BAUD_DISCOVERY, default=True): cv.boolean,
+        cv.Optional(CONF_MAX_RETRIES, default=2): cv.int_range(min=0, max=5),
+        # FreeRTOS task tuning: defaults come from measured stack high-water marks
+        # (logged in dump_config); the RX task runs one priority notch above the
+        # polling task. pin_to_core keeps both tasks off the WiFi/main core.
+        cv.Optional(CONF_TASK_STACK_SIZE, default=4096): cv.int_range(min=2048, max=16384),
+        cv.Optional(CONF_RX_TASK_STACK_SIZE, default=2048): cv.int_range(min=1024, max=8192),
+        cv.Optional(CONF_TASK_PRIORITY, default=5): cv.int_range(min=1, max=20),
+        cv.Optional(CONF_PIN_TO_CORE, default=-1): cv.int_range(min=-1, max=1),
+        # Flight recorder: binary TX/RX frame event ring for offline replay (0 = off)
+        cv.Optional(CONF_FLIGHT_RECORDER_SIZE, default=0): cv.int_range(min=0, max=16384),
+
         # DL/T 645-2007 
         cv.Optional(CONF_ON_DEVICE_ADDRESS): automation.validate_automation(
             {
@@ -175,9 +359,43 @@ CONFIG_SCHEMA = cv.Schema(
                 cv.Optional("status"): cv.uint32_t,
             }
         ),
+        cv.Optional(CONF_STATS_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_ON_STATS): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(StatsTrigger),
+            }
+        ),
+        cv.Optional(CONF_ON_VALUE): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ValueTrigger),
+            }
+        ),
+        cv.Optional(CONF_ON_ACTION_RESULT): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ActionResultTrigger),
+            }
+        ),
+        cv.Optional(CONF_ON_BURST_CAPTURE): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(BurstCaptureTrigger),
+            }
+        ),
+        # Deep-sleep duty cycling: measure the listed DIs once on boot (warm identity
+        # cache, no rotation), fire on_one_shot_complete, and stop polling
+        cv.Optional(CONF_ONE_SHOT_MODE, default=False): cv.boolean,
+        cv.Optional(
+            CONF_ONE_SHOT_READINGS, default=["active_power", "energy_active"]
+        ): cv.ensure_list(cv.one_of(*REFRESH_INTERVAL_CHANNELS, lower=True)),
+        cv.Optional(CONF_ON_ONE_SHOT_COMPLETE): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(OneShotCompleteTrigger),
+            }
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
+CONFIG_SCHEMA = cv.All(CONFIG_SCHEMA, validate_channels)
+
 
 async def to_code(config):
     """"""
@@ -189,9 +407,71 @@ async def to_code(config):
     cg.add(var.set_power_ratio(config[CONF_POWER_RATIO]))
     cg.add(var.set_tx_pin(config[CONF_TX_PIN]))
     cg.add(var.set_rx_pin(config[CONF_RX_PIN]))
+    if CONF_DE_PIN in config:
+        cg.add(var.set_de_pin(config[CONF_DE_PIN]))
     cg.add(var.set_baud_rate(config[CONF_BAUD_RATE]))
     cg.add(var.set_rx_buffer_size(config[CONF_RX_BUFFER_SIZE]))
     cg.add(var.set_simulate(config[CONF_SIMULATE]))
+    cg.add(var.set_simulate_interval(config[CONF_SIMULATE_INTERVAL].total_milliseconds))
+    cg.add(var.set_simulate_seed(config[CONF_SIMULATE_SEED]))
+    cg.add(var.set_simulate_inject_frames(config[CONF_SIMULATE_INJECT_FRAMES]))
+    cg.add(var.set_burst_cycle(config[CONF_BURST_CYCLE]))
+
+    # Channel compile-out: with an explicit channel set, only the declared channels
+    # get their DLT645_USE_* define; everything else drops out of the binary
+    if CONF_CHANNELS in config:
+        cg.add_define("DLT645_CHANNELS_CONFIGURED")
+        for channel in config[CONF_CHANNELS]:
+            cg.add_define(CHANNEL_DEFINES[channel])
+
+    # Multi-meter bus: each address is BCD encoded, low byte first
+    # e.g. meter ID "123456789012" -> [0x12, 0x90, 0x78, 0x56, 0x34, 0x12]
+    for address in config.get(CONF_METER_ADDRESSES, []):
+        address_bytes = [int(address[i : i + 2], 16) for i in range(0, 12, 2)][::-1]
+        cg.add(var.add_meter_address(address_bytes))
+
+    # Deadline scheduler: per-channel refresh intervals replace the power_ratio rotation
+    for name, interval in config.get(CONF_REFRESH_INTERVALS, {}).items():
+        cg.add(var.set_refresh_interval(REFRESH_INTERVAL_CHANNELS[name], interval.total_milliseconds))
+
+    # Delta suppression deadbands and forced heartbeat
+    deadbands = config.get(CONF_DEADBANDS, {})
+    deadband_setters = {
+        "active_power": var.set_deadband_power,
+        "voltage_a": var.set_deadband_voltage,
+        "current_a": var.set_deadband_current,
+        "power_factor": var.set_deadband_power_factor,
+        "frequency": var.set_deadband_frequency,
+        "energy": var.set_deadband_energy,
+    }
+    for name, value in deadbands.items():
+        cg.add(deadband_setters[name](value))
+    cg.add(var.set_heartbeat_interval(config[CONF_HEARTBEAT_INTERVAL].total_milliseconds))
+    cg.add(var.set_event_drain_budget(config[CONF_EVENT_DRAIN_BUDGET]))
+    cg.add(var.set_passive_listen(config[CONF_PASSIVE_LISTEN]))
+    cg.add(var.set_fast_baud_discovery(config[CONF_FAST_BAUD_DISCOVERY]))
+    # Generic register engine: declared DIs feed the runtime descriptor table
+    for reg in config.get(CONF_REGISTERS, []):
+        cg.add(
+            var.add_custom_register(
+                reg["data_identifier"],
+                reg["length"],
+                reg["decimal_places"],
+                reg["signed"],
+                reg["scale"],
+                reg["count"],
+                reg["interval"].total_milliseconds,
+                reg["name"],
+            )
+        )
+
+    cg.add(var.set_stats_interval(config[CONF_STATS_INTERVAL].total_milliseconds))
+    cg.add(var.set_max_retries(config[CONF_MAX_RETRIES]))
+    cg.add(var.set_task_stack_size(config[CONF_TASK_STACK_SIZE]))
+    cg.add(var.set_rx_task_stack_size(config[CONF_RX_TASK_STACK_SIZE]))
+    cg.add(var.set_task_priority(config[CONF_TASK_PRIORITY]))
+    cg.add(var.set_pin_to_core(config[CONF_PIN_TO_CORE]))
+    cg.add(var.set_flight_recorder_size(config[CONF_FLIGHT_RECORDER_SIZE]))
     
     # DL/T 645-2007
     
@@ -255,6 +535,43 @@ async def to_code(config):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         await automation.build_automation(trigger, [(cg.uint32, "data_identifier"), (cg.uint32, "status")], conf)
 
+    # On-wire telemetry snapshot (counters + latency histograms)
+    for conf in config.get(CONF_ON_STATS, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(DLT645Stats, "stats")], conf)
+
+    # Generic register values - Parameters: data_identifier + value index + decoded value
+    for conf in config.get(CONF_ON_VALUE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(
+            trigger, [(cg.uint32, "data_identifier"), (cg.uint32, "index"), (cg.float_, "value")], conf
+        )
+
+    # Async action completion - Parameters: token + request type + result code
+    # (0=SUCCESS, 1=ERROR_RESPONSE, 2=TIMEOUT, 3=SEND_FAILED)
+    for conf in config.get(CONF_ON_ACTION_RESULT, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(
+            trigger, [(cg.uint32, "token"), (cg.uint8, "request"), (cg.uint8, "result")], conf
+        )
+
+    # Burst capture window closed - Parameter: sample count (samples readable via
+    # get_burst_capture_samples() in lambdas)
+    for conf in config.get(CONF_ON_BURST_CAPTURE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint32, "sample_count")], conf)
+
+    # One-shot duty-cycle mode for deep-sleep installs
+    if config[CONF_ONE_SHOT_MODE]:
+        cg.add(var.set_one_shot_mode(True))
+        for name in config[CONF_ONE_SHOT_READINGS]:
+            cg.add(var.add_one_shot_reading(REFRESH_INTERVAL_CHANNELS[name]))
+
+    # One-shot pass finished - Parameter: number of readings that got a valid response
+    for conf in config.get(CONF_ON_ONE_SHOT_COMPLETE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint32, "ok_count")], conf)
+
 
 # DL/T 645-2007 继电器控制 Actions
 @automation.register_action(
@@ -330,3 +647,39 @@ async def broadcast_time_sync_action_to_code(config, action_id, template_arg, ar
     """Broadcast time synchronization - Uses control code 0x08 to sync time to all meters (YY MM DD HH mm - 5 bytes)"""
     parent = await cg.get_variable(config[CONF_ID])
     return cg.new_Pvariable(action_id, template_arg, parent)
+
+
+@automation.register_action(
+    "dlt645_component.burst_capture",
+    BurstCaptureAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(DLT645Component),
+            cv.Optional(CONF_DURATION, default="30s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(seconds=1), max=cv.TimePeriod(seconds=120)),
+            ),
+        }
+    ),
+)
+async def burst_capture_action_to_code(config, action_id, template_arg, args):
+    """Start a burst capture window - high-frequency power sampling, delivered as one batch"""
+    parent = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, parent)
+    cg.add(var.set_duration(config[CONF_DURATION].total_milliseconds))
+    return var
+
+
+@automation.register_action(
+    "dlt645_component.dump_flight_recorder",
+    DumpFlightRecorderAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(DLT645Component),
+        }
+    ),
+)
+async def dump_flight_recorder_action_to_code(config, action_id, template_arg, args):
+    """Dump the flight recorder ring as replayable FR log lines (see tests/host/flight_replay)"""
+    parent = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, parent)
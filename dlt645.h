@@ -3,10 +3,21 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+
+#include "dlt645_codec.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
 
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
 #include "driver/gpio.h"
 #include "driver/uart.h"
+#include "esp_task_wdt.h"
 #include "esp_timer.h"
 #include "freertos/event_groups.h"
 #include "freertos/FreeRTOS.h"
@@ -15,6 +26,8 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -25,13 +38,47 @@
 namespace esphome {
 namespace dlt645_component {
 
-// FreeRTOS task configuration constants
-constexpr uint32_t DLT645_TASK_STACK_SIZE = 4096; // 4KB stack size
+// FreeRTOS task configuration constants (defaults; both stacks and the priority are
+// overridable from YAML). The polling task owns frame building, parsing and dispatch;
+// the RX task only drains the UART driver, so it runs on a much smaller stack.
+constexpr uint32_t DLT645_TASK_STACK_SIZE = 4096;    // Polling/parse task stack
+constexpr uint32_t DLT645_RX_TASK_STACK_SIZE = 2048; // RX/byte-drain task stack
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
 constexpr UBaseType_t DLT645_TASK_PRIORITY = 5; // Medium priority
 constexpr UBaseType_t DLT645_REQUEST_QUEUE_LENGTH = 8; // Queue length for incoming requests
+constexpr UBaseType_t DLT645_UART_EVENT_QUEUE_LENGTH = 16; // Queue length for UART driver events
+constexpr UBaseType_t DLT645_RX_CHUNK_QUEUE_LENGTH = 8; // Byte batches in flight between RX and parse stage
 #endif
 constexpr uint32_t DLT645_TRIGGER_INTERVAL_MS = 5000; // 5 second interval
+constexpr uint32_t DLT645_INTER_FRAME_GAP_MS = 50; // Protocol-mandated gap between back-to-back frames
+constexpr uint32_t DLT645_RETRY_BACKOFF_BASE_MS = 50; // First in-cycle retry delay, doubled per attempt
+constexpr uint32_t DLT645_WDT_FEED_INTERVAL_MS = 1000; // Longest uninterrupted sleep slice between watchdog feeds
+
+// === YAML-driven channel compile-out ===
+// __init__.py emits DLT645_CHANNELS_CONFIGURED plus one DLT645_USE_* define per
+// channel declared under `channels:` in YAML, so unused descriptor entries, parse
+// branches, callbacks and trigger classes drop out of flash and static RAM.
+// Builds without codegen (host harness, direct compilation) keep every channel.
+#ifndef DLT645_CHANNELS_CONFIGURED
+#define DLT645_USE_ACTIVE_POWER
+#define DLT645_USE_ENERGY_ACTIVE
+#define DLT645_USE_VOLTAGE_A
+#define DLT645_USE_CURRENT_A
+#define DLT645_USE_POWER_FACTOR
+#define DLT645_USE_FREQUENCY
+#define DLT645_USE_ENERGY_REVERSE
+#define DLT645_USE_DATETIME
+#define DLT645_USE_TIME_HMS
+#define DLT645_USE_RELAY_STATUS
+#endif
+
+// === Compile-time frame tracing ===
+// Hex dumps of TX/RX frames only exist in VERY_VERBOSE builds: with tracing off the
+// hot path performs zero formatting and zero allocation for them. The dumps format
+// into reused stack buffers instead of heap strings even when enabled.
+#if defined(ESPHOME_LOG_LEVEL) && ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
+#define DLT645_TRACE_FRAMES
+#endif
 
 // DL/T 645-2007 data identifier enumeration definitions
 enum class DLT645_DATA_IDENTIFIER : uint32_t
@@ -78,6 +125,154 @@ enum class DLT645_REQUEST_TYPE : uint32_t
     CONTROL_RELAY_DISCONNECT = 0x23     // Relay disconnect
 };
 
+// Poll scheduling guard for the compile-out: the rotation, the deadline scheduler
+// and the burst sweep skip request types whose channel is not compiled in.
+// Non-read types (writes, controls, discovery) are always available.
+constexpr bool dlt645_channel_compiled(DLT645_REQUEST_TYPE type)
+{
+    switch (type) {
+#ifndef DLT645_USE_ACTIVE_POWER
+    case DLT645_REQUEST_TYPE::READ_ACTIVE_POWER_TOTAL:
+        return false;
+#endif
+#ifndef DLT645_USE_ENERGY_ACTIVE
+    case DLT645_REQUEST_TYPE::READ_ENERGY_ACTIVE_TOTAL:
+        return false;
+#endif
+#ifndef DLT645_USE_VOLTAGE_A
+    case DLT645_REQUEST_TYPE::READ_VOLTAGE_A_PHASE:
+        return false;
+#endif
+#ifndef DLT645_USE_CURRENT_A
+    case DLT645_REQUEST_TYPE::READ_CURRENT_A_PHASE:
+        return false;
+#endif
+#ifndef DLT645_USE_POWER_FACTOR
+    case DLT645_REQUEST_TYPE::READ_POWER_FACTOR_TOTAL:
+        return false;
+#endif
+#ifndef DLT645_USE_FREQUENCY
+    case DLT645_REQUEST_TYPE::READ_FREQUENCY:
+        return false;
+#endif
+#ifndef DLT645_USE_ENERGY_REVERSE
+    case DLT645_REQUEST_TYPE::READ_ENERGY_REVERSE_TOTAL:
+        return false;
+#endif
+#ifndef DLT645_USE_DATETIME
+    case DLT645_REQUEST_TYPE::READ_DATE:
+        return false;
+#endif
+#ifndef DLT645_USE_TIME_HMS
+    case DLT645_REQUEST_TYPE::READ_TIME:
+        return false;
+#endif
+    default:
+        return true;
+    }
+}
+
+// Async action completion: every queued control/write action gets a monotonically
+// increasing token when it is enqueued, and the wire outcome is reported back through
+// the on_action_result callback surface once the response frame is parsed (or the
+// send attempt is exhausted).
+enum class DLT645_ACTION_RESULT : uint8_t
+{
+    SUCCESS = 0,        // Acknowledgment frame received (0x9C/0x94/0x88), or broadcast sent
+    ERROR_RESPONSE = 1, // Meter replied with an error control code (0xDC/0xBC)
+    TIMEOUT = 2,        // Frame sent but no response within the command timeout
+    SEND_FAILED = 3     // Frame never hit the wire (invalid address, TX failure)
+};
+
+// Byte batch handed from the RX task to the frame-assembly/parse stage on the polling
+// task. A zero-length chunk is the overflow marker: the RX task flushed the driver
+// after an overrun and the ring must be discarded.
+constexpr size_t DLT645_RX_CHUNK_SIZE = 64;
+struct DLT645RxChunk
+{
+    uint8_t length;
+    uint8_t data[DLT645_RX_CHUNK_SIZE];
+};
+
+// Burst capture: short-window high-frequency power sampling for inrush and
+// load-signature analysis. Samples land in a buffer reserved once (no per-sample
+// allocation) and the whole batch is delivered through one callback when the
+// window closes, instead of one trigger firing per sample.
+constexpr size_t DLT645_BURST_CAPTURE_MAX_SAMPLES = 256;
+
+struct DLT645BurstSample
+{
+    uint32_t timestamp_ms; // Sample time (ms since boot)
+    float power_w;         // Active power reading (W)
+};
+
+// Control queue element: the request plus its completion token (0 = no report wanted)
+struct DLT645ControlRequest
+{
+    DLT645_REQUEST_TYPE request;
+    uint32_t token;
+};
+
+// Completed action record, handed from the polling task to the main loop
+struct DLT645ActionOutcome
+{
+    uint32_t token;
+    DLT645_REQUEST_TYPE request;
+    DLT645_ACTION_RESULT result;
+};
+
+// === Unified compile-time DI descriptor table ===
+// Consolidates the format knowledge (payload length, decimal places, sign handling,
+// scale factor, event bit) for every numeric data identifier in one place, so the
+// parser, the event dispatcher and the polling tables cannot drift apart.
+struct DLT645DiDescriptor
+{
+    DLT645_DATA_IDENTIFIER di; // Data identifier
+    uint32_t event_bit;        // Event group bit value (matches the EVENT_DI_* constants)
+    uint8_t min_data_bytes;    // Minimum decoded payload length in bytes
+    uint8_t decimal_places;    // BCD decimal places
+    bool has_sign;             // Sign bit in the MSB of the last BCD byte
+    float scale;               // Multiplier applied after decode (e.g. kW -> W)
+    const char* name;          // Channel name for logging
+};
+
+// Numeric channels only: device address, datetime and time keep dedicated parse paths.
+// Compiled-out channels drop their table entry, so the parser treats their DI as unknown.
+constexpr DLT645DiDescriptor DLT645_DI_DESCRIPTORS[] = {
+#ifdef DLT645_USE_ACTIVE_POWER
+    {DLT645_DATA_IDENTIFIER::ACTIVE_POWER_TOTAL, (1u << 2), 3, 4, true, 1000.0f, "Active Power Total"},
+#endif
+#ifdef DLT645_USE_ENERGY_ACTIVE
+    {DLT645_DATA_IDENTIFIER::ENERGY_ACTIVE_TOTAL, (1u << 3), 4, 2, false, 1.0f, "Energy Active Total"},
+#endif
+#ifdef DLT645_USE_VOLTAGE_A
+    {DLT645_DATA_IDENTIFIER::VOLTAGE_A_PHASE, (1u << 4), 2, 1, false, 1.0f, "Voltage A Phase"},
+#endif
+#ifdef DLT645_USE_CURRENT_A
+    {DLT645_DATA_IDENTIFIER::CURRENT_A_PHASE, (1u << 5), 3, 3, true, 1.0f, "Current A Phase"},
+#endif
+#ifdef DLT645_USE_POWER_FACTOR
+    {DLT645_DATA_IDENTIFIER::POWER_FACTOR_TOTAL, (1u << 6), 2, 3, true, 1.0f, "Power Factor Total"},
+#endif
+#ifdef DLT645_USE_FREQUENCY
+    {DLT645_DATA_IDENTIFIER::FREQUENCY, (1u << 7), 2, 2, false, 1.0f, "Frequency"},
+#endif
+#ifdef DLT645_USE_ENERGY_REVERSE
+    {DLT645_DATA_IDENTIFIER::ENERGY_REVERSE_TOTAL, (1u << 8), 4, 2, false, 1.0f, "Energy Reverse Total"},
+#endif
+};
+
+// Compile-time lookup: returns nullptr for DIs without a numeric descriptor
+constexpr const DLT645DiDescriptor* dlt645_find_descriptor(uint32_t data_identifier)
+{
+    for (const auto& desc : DLT645_DI_DESCRIPTORS) {
+        if (static_cast<uint32_t>(desc.di) == data_identifier) {
+            return &desc;
+        }
+    }
+    return nullptr;
+}
+
 // Event Group event bit definitions - Event bits corresponding to DL/T 645-2007 data identifiers
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
 const EventBits_t EVENT_GENERAL = BIT0;                 // BIT0: Keep original general event
@@ -92,18 +287,369 @@ const EventBits_t EVENT_DI_ENERGY_REVERSE_TOTAL = BIT8; // BIT8: Reverse total e
 const EventBits_t EVENT_DI_DATETIME = BIT9;             // BIT9: Date and time
 const EventBits_t EVENT_DI_TIME_HMS = BIT10;            // BIT10: Hours, minutes, seconds
 const EventBits_t EVENT_DI_RELAY_STATUS = BIT11;        // BIT11: Relay status
+const EventBits_t EVENT_DI_CUSTOM_REGISTER = BIT12;     // BIT12: Any YAML-declared custom register
+const EventBits_t EVENT_ACTION_RESULT = BIT13;          // BIT13: A queued action completed on the wire
+const EventBits_t EVENT_BURST_CAPTURE = BIT14;          // BIT14: A burst capture window closed
+const EventBits_t EVENT_ONE_SHOT_COMPLETE = BIT15;      // BIT15: One-shot measurement pass finished
 
-// Mask for all DL/T 645 event bits (BIT1-BIT11)
+// Mask for all DL/T 645 event bits (BIT1-BIT15)
 const EventBits_t ALL_DLT645_EVENTS = EVENT_DI_DEVICE_ADDRESS | EVENT_DI_ACTIVE_POWER_TOTAL |
                                       EVENT_DI_ENERGY_ACTIVE_TOTAL | EVENT_DI_VOLTAGE_A_PHASE |
                                       EVENT_DI_CURRENT_A_PHASE | EVENT_DI_POWER_FACTOR_TOTAL | EVENT_DI_FREQUENCY |
                                       EVENT_DI_ENERGY_REVERSE_TOTAL | EVENT_DI_DATETIME | EVENT_DI_TIME_HMS |
-                                      EVENT_DI_RELAY_STATUS;
+                                      EVENT_DI_RELAY_STATUS | EVENT_DI_CUSTOM_REGISTER | EVENT_ACTION_RESULT |
+                                      EVENT_BURST_CAPTURE | EVENT_ONE_SHOT_COMPLETE;
 
 // Mask for all event bits (including original EVENT_GENERAL)
 const EventBits_t ALL_EVENTS = EVENT_GENERAL | ALL_DLT645_EVENTS;
 #endif
 
+// Fixed-capacity ring buffer for the DL/T 645 RX path.
+// Storage is allocated once (from dlt645_rx_buffer_size_) when the component is set up;
+// the polling task appends received byte batches and the incremental parser consumes
+// whole frames, so the per-poll path never touches the heap.
+class DLT645RxRing
+{
+public:
+    // Allocate the backing storage once; called from setup() before the task starts
+    void init(size_t capacity)
+    {
+        this->storage_.assign(capacity, 0);
+        this->clear();
+    }
+
+    void clear()
+    {
+        this->tail_ = 0;
+        this->count_ = 0;
+    }
+
+    size_t size() const
+    {
+        return this->count_;
+    }
+
+    size_t capacity() const
+    {
+        return this->storage_.size();
+    }
+
+    // Append a batch of received bytes; on overflow the oldest bytes are dropped
+    void push(const uint8_t* data, size_t len)
+    {
+        if (this->storage_.empty()) {
+            return;
+        }
+        for (size_t i = 0; i < len; i++) {
+            size_t write_index = (this->tail_ + this->count_) % this->storage_.size();
+            this->storage_[write_index] = data[i];
+            if (this->count_ < this->storage_.size()) {
+                this->count_++;
+            } else {
+                // Full: overwrite the oldest byte and advance the read position
+                this->tail_ = (this->tail_ + 1) % this->storage_.size();
+            }
+        }
+    }
+
+    // Random access relative to the oldest unconsumed byte
+    uint8_t operator[](size_t index) const
+    {
+        return this->storage_[(this->tail_ + index) % this->storage_.size()];
+    }
+
+    // Drop n consumed bytes from the front (e.g. 0xFE preamble or a completed frame)
+    void consume(size_t n)
+    {
+        if (n >= this->count_) {
+            this->clear();
+            return;
+        }
+        this->tail_ = (this->tail_ + n) % this->storage_.size();
+        this->count_ -= n;
+    }
+
+private:
+    std::vector<uint8_t> storage_;
+    size_t tail_{0};
+    size_t count_{0};
+};
+
+// === Flight recorder ===
+// Fixed-size binary ring of timestamped TX/RX frame events, preallocated at setup
+// (flight_recorder_size, 0 = disabled). Recording costs one bounded copy per event
+// instead of the multi-line hex formatting of VERY_VERBOSE logs, so it does not
+// distort the timing it is meant to diagnose. The dump action prints records as
+// `FR <index> <ms> <TX|RX> <hex>` lines that tests/host/flight_replay feeds back
+// through the parser for offline analysis.
+constexpr size_t DLT645_FLIGHT_RECORD_MAX_PAYLOAD = 64; // Stored bytes per event (longer frames truncate)
+
+class DLT645FlightRecorder
+{
+public:
+    // Record layout inside the byte ring: 4-byte little-endian timestamp (ms),
+    // 1 direction byte (1 = TX), 1 stored-length byte, then the payload bytes
+    static constexpr size_t HEADER_SIZE = 6;
+
+    // Allocate the backing storage once; called from setup() before the task starts
+    void init(size_t capacity)
+    {
+        this->storage_.assign(capacity, 0);
+        this->clear();
+    }
+
+    bool enabled() const
+    {
+        return !this->storage_.empty();
+    }
+
+    void clear()
+    {
+        this->tail_ = 0;
+        this->used_ = 0;
+        this->dropped_ = 0;
+    }
+
+    size_t used() const
+    {
+        return this->used_;
+    }
+
+    size_t capacity() const
+    {
+        return this->storage_.size();
+    }
+
+    uint32_t dropped() const
+    {
+        return this->dropped_;
+    }
+
+    // Append one frame event, evicting the oldest whole records until it fits
+    void record(bool tx, const uint8_t* data, size_t length, uint32_t timestamp_ms)
+    {
+        if (this->storage_.empty() || data == nullptr) {
+            return;
+        }
+        uint8_t stored = length > DLT645_FLIGHT_RECORD_MAX_PAYLOAD
+                             ? static_cast<uint8_t>(DLT645_FLIGHT_RECORD_MAX_PAYLOAD)
+                             : static_cast<uint8_t>(length);
+        size_t record_size = HEADER_SIZE + stored;
+        if (record_size > this->storage_.size()) {
+            return;
+        }
+        while (this->storage_.size() - this->used_ < record_size) {
+            this->evict_oldest_();
+        }
+        uint8_t header[HEADER_SIZE] = {
+            static_cast<uint8_t>(timestamp_ms & 0xFF),
+            static_cast<uint8_t>((timestamp_ms >> 8) & 0xFF),
+            static_cast<uint8_t>((timestamp_ms >> 16) & 0xFF),
+            static_cast<uint8_t>((timestamp_ms >> 24) & 0xFF),
+            static_cast<uint8_t>(tx ? 0x01 : 0x00),
+            stored,
+        };
+        this->append_(header, HEADER_SIZE);
+        this->append_(data, stored);
+    }
+
+    // Visit records oldest-first; visitor(timestamp_ms, tx, payload, length).
+    // The payload pointer is a reused scratch buffer (records may wrap the ring).
+    template<typename Visitor> void for_each(Visitor&& visitor) const
+    {
+        uint8_t scratch[DLT645_FLIGHT_RECORD_MAX_PAYLOAD];
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= this->used_) {
+            uint32_t timestamp_ms = static_cast<uint32_t>(this->byte_(offset)) |
+                                    (static_cast<uint32_t>(this->byte_(offset + 1)) << 8) |
+                                    (static_cast<uint32_t>(this->byte_(offset + 2)) << 16) |
+                                    (static_cast<uint32_t>(this->byte_(offset + 3)) << 24);
+            bool tx = this->byte_(offset + 4) != 0;
+            uint8_t length = this->byte_(offset + 5);
+            if (length > DLT645_FLIGHT_RECORD_MAX_PAYLOAD || offset + HEADER_SIZE + length > this->used_) {
+                break; // Torn record (dump raced a concurrent write); stop cleanly
+            }
+            for (uint8_t i = 0; i < length; i++) {
+                scratch[i] = this->byte_(offset + HEADER_SIZE + i);
+            }
+            visitor(timestamp_ms, tx, scratch, length);
+            offset += HEADER_SIZE + length;
+        }
+    }
+
+private:
+    uint8_t byte_(size_t index) const
+    {
+        return this->storage_[(this->tail_ + index) % this->storage_.size()];
+    }
+
+    void append_(const uint8_t* data, size_t length)
+    {
+        for (size_t i = 0; i < length; i++) {
+            this->storage_[(this->tail_ + this->used_ + i) % this->storage_.size()] = data[i];
+        }
+        this->used_ += length;
+    }
+
+    void evict_oldest_()
+    {
+        if (this->used_ < HEADER_SIZE) {
+            this->tail_ = 0;
+            this->used_ = 0;
+            return;
+        }
+        uint8_t length = this->byte_(5);
+        size_t record_size = HEADER_SIZE + length;
+        if (record_size > this->used_) {
+            record_size = this->used_;
+        }
+        this->tail_ = (this->tail_ + record_size) % this->storage_.size();
+        this->used_ -= record_size;
+        this->dropped_++;
+    }
+
+    std::vector<uint8_t> storage_;
+    size_t tail_{0};
+    size_t used_{0};
+    uint32_t dropped_{0}; // Records evicted to make room (ring wrapped)
+};
+
+// Last-published value tracking for delta-suppressed callback dispatch.
+// One instance per float channel; see DLT645Component::should_publish_().
+struct DLT645PublishState
+{
+    float last_value{NAN};       // NAN until the first publish
+    uint32_t last_publish_ms{0}; // Timestamp of the last dispatched callback
+};
+
+// === Generic register engine ===
+// YAML-declared data identifiers beyond the built-in channel set (three-phase
+// voltage/current, demand, tariff energy). Each entry carries its BCD decode
+// format; block-read DIs yield `count` packed values from a single frame.
+constexpr uint8_t DLT645_CUSTOM_REGISTER_MAX_VALUES = 8;
+
+struct DLT645CustomRegister
+{
+    uint32_t di{0};             // Data identifier to poll
+    uint8_t value_bytes{2};     // BCD bytes per value
+    uint8_t decimal_places{1};  // BCD decimal places per value
+    bool has_sign{false};       // Sign bit in the MSB of the last byte of each value
+    float scale{1.0f};          // Multiplier applied after decode
+    uint8_t count{1};           // Values packed in one response (block reads)
+    uint32_t interval_ms{5000}; // Poll interval
+    std::string name;           // For logging
+
+    // Runtime state: the polling task decodes into values[] and raises the custom
+    // event bit; the main loop dispatches callbacks and clears `pending`
+    uint32_t next_due_ms{0};
+    float values[DLT645_CUSTOM_REGISTER_MAX_VALUES]{};
+    uint8_t value_count{0};
+    bool pending{false};
+};
+
+// Latency histogram bucket upper bounds in milliseconds; the last bucket is open-ended.
+// Chosen so a healthy meter (first byte within one or two frame times) lands in the
+// first buckets and a baud mismatch or sluggish meter is immediately visible at the tail.
+constexpr uint32_t DLT645_STATS_LATENCY_BOUNDS_MS[] = {50, 100, 200, 400, 800, 1600};
+constexpr size_t DLT645_STATS_BUCKET_COUNT = (sizeof(DLT645_STATS_LATENCY_BOUNDS_MS) / sizeof(DLT645_STATS_LATENCY_BOUNDS_MS[0])) + 1;
+
+// Round-trip latency accounting for one request type: command sent to first response byte.
+struct DLT645LatencyStats
+{
+    uint32_t count{0};
+    uint32_t min_ms{0};
+    uint32_t max_ms{0};
+    uint64_t total_ms{0};
+    uint32_t buckets[DLT645_STATS_BUCKET_COUNT]{};
+
+    void record(uint32_t latency_ms)
+    {
+        if (this->count == 0 || latency_ms < this->min_ms) {
+            this->min_ms = latency_ms;
+        }
+        if (latency_ms > this->max_ms) {
+            this->max_ms = latency_ms;
+        }
+        this->total_ms += latency_ms;
+        this->count++;
+        size_t bucket = 0;
+        while (bucket < DLT645_STATS_BUCKET_COUNT - 1 && latency_ms > DLT645_STATS_LATENCY_BOUNDS_MS[bucket]) {
+            bucket++;
+        }
+        this->buckets[bucket]++;
+    }
+
+    float average_ms() const
+    {
+        return this->count > 0 ? static_cast<float>(this->total_ms) / this->count : 0.0f;
+    }
+};
+
+// On-wire telemetry counters. Written only by the FreeRTOS polling task and read from the
+// ESPHome main loop with the same relaxed single-writer discipline as the cached readings.
+// The one counter produced by the RX task (rx_overflows) is accumulated in a separate
+// atomic and folded into this struct by the polling task, keeping the discipline intact.
+struct DLT645Stats
+{
+    uint32_t frames_sent{0};      // Frames put on the wire
+    uint32_t responses_ok{0};     // Frames that passed full validation
+    uint32_t timeouts{0};         // Command timeouts with no response byte at all
+    uint32_t checksum_errors{0};  // Frames rejected by checksum
+    uint32_t error_responses{0};  // Meter error replies (0xD1/0xB1/0xDC/0xBC)
+    uint32_t rx_overflows{0};     // UART RX FIFO/buffer overruns
+    uint32_t retries{0};          // Re-sends after a failed attempt
+    uint32_t rx_chunks{0};        // Byte batches handed over by the RX task
+    uint32_t rx_bytes{0};         // Response bytes received (replaces per-batch logging)
+    uint32_t deadline_overruns{0}; // Transactions aborted for exceeding their wire-time budget
+    uint32_t cycle_overruns{0};   // Poll cycles that blew their period (burst mode)
+    uint64_t bus_busy_ms{0};      // Time the bus was occupied by our transactions
+    uint32_t window_start_ms{0};  // Start of the current accounting window
+
+    // Per-request-type latency, indexed like refresh_interval_ms_ (by DLT645_REQUEST_TYPE)
+    DLT645LatencyStats latency[static_cast<size_t>(DLT645_REQUEST_TYPE::READ_POS_END) + 1];
+};
+
+// Consistent snapshot of every cached meter reading. Filled by the FreeRTOS polling
+// task under a sequence lock and copied out tear-free by get_meter_readings(), so the
+// main loop, lambdas and future custom components can read values on demand without
+// going through the trigger machinery or blocking the polling task.
+struct DLT645MeterReadings
+{
+    float active_power_w{0.0f};
+    float energy_active_kwh{0.0f};
+    float voltage_a_v{0.0f};
+    float current_a_a{0.0f};
+    float power_factor{0.0f};
+    float frequency_hz{0.0f};
+    float energy_reverse_kwh{0.0f};
+    uint32_t relay_status{0};
+    uint32_t last_update_ms{0}; // Timestamp of the most recent field update
+};
+
+// Per-meter state for multi-meter buses (several DL/T 645 meters sharing one RS-485 pair).
+// The polling rotation round-robins through this table so N meters share the poll cycle
+// instead of requiring one ESP32 per meter. Readings and publish state live per meter:
+// the polling task writes `readings` at parse time and the main loop owns the publish
+// records, so one meter's values never overwrite another's before dispatch and a
+// deadband always compares against the same meter's last publish.
+struct DLT645MeterState
+{
+    std::vector<uint8_t> address; // 6-byte BCD address, LSB first (empty until discovered)
+    bool discovered{false};       // Whether the address has been confirmed on the wire
+
+    // Cached readings for this meter, written only by the polling task at parse time
+    DLT645MeterReadings readings;
+
+    // Last-published value per float channel, main-loop only (see should_publish_())
+    DLT645PublishState publish_power;
+    DLT645PublishState publish_voltage_a;
+    DLT645PublishState publish_current_a;
+    DLT645PublishState publish_power_factor;
+    DLT645PublishState publish_frequency;
+    DLT645PublishState publish_energy_active;
+    DLT645PublishState publish_energy_reverse;
+};
+
 class DLT645Component : public Component
 {
 public:
@@ -121,6 +667,14 @@ public:
         this->dlt645_rx_pin_ = pin;
     }
 
+    // RS-485 DE/RE driver-enable GPIO, wired to the UART RTS signal. When set,
+    // the UART runs in hardware half-duplex mode and releases the bus right
+    // after the last stop bit - no auto-direction transceiver needed.
+    void set_de_pin(int pin)
+    {
+        this->dlt645_de_pin_ = pin;
+    }
+
     void set_baud_rate(int rate)
     {
         this->dlt645_baud_rate_ = rate;
@@ -138,6 +692,70 @@ public:
         this->dlt645_rx_buffer_size_ = size;
     }
 
+    // Flight recorder ring size in bytes (0 = disabled); allocated once in setup()
+    void set_flight_recorder_size(int size)
+    {
+        this->flight_recorder_size_ = size;
+    }
+
+    // Dump every recorded frame event to the log as replayable `FR` lines.
+    // Diagnostic surface: recording continues while dumping, so the newest entries
+    // may be cut off; everything older is consistent.
+    void dump_flight_recorder();
+
+    // Fast baud discovery: probe each rate with a timeout derived from the theoretical
+    // frame time instead of the full discovery timeout, and remember the last working
+    // rate across reboots so startup-to-first-reading stays short
+    void set_fast_baud_discovery(bool enable)
+    {
+        this->fast_baud_discovery_ = enable;
+    }
+
+    // In-cycle retry budget for failed reads (0 disables retries)
+    void set_max_retries(uint8_t max_retries)
+    {
+        this->max_retries_ = max_retries;
+    }
+
+    // Generic register engine: declare an extra DI to poll (from YAML `registers:`)
+    void add_custom_register(uint32_t di, uint8_t value_bytes, uint8_t decimal_places, bool has_sign, float scale,
+                             uint8_t count, uint32_t interval_ms, const std::string& name)
+    {
+        DLT645CustomRegister reg;
+        reg.di = di;
+        reg.value_bytes = value_bytes;
+        reg.decimal_places = decimal_places;
+        reg.has_sign = has_sign;
+        reg.scale = scale;
+        reg.count = count > DLT645_CUSTOM_REGISTER_MAX_VALUES ? DLT645_CUSTOM_REGISTER_MAX_VALUES : count;
+        reg.interval_ms = interval_ms;
+        reg.name = name;
+        this->custom_registers_.push_back(reg);
+    }
+
+    // FreeRTOS task tuning: stack sizes for the polling/parse task and the RX task,
+    // the polling task priority (RX runs one notch above it so bytes drain promptly),
+    // and an optional core to pin both tasks to (-1 = scheduler decides)
+    void set_task_stack_size(uint32_t stack_size)
+    {
+        this->task_stack_size_ = stack_size;
+    }
+
+    void set_rx_task_stack_size(uint32_t stack_size)
+    {
+        this->rx_task_stack_size_ = stack_size;
+    }
+
+    void set_task_priority(uint8_t priority)
+    {
+        this->task_priority_ = priority;
+    }
+
+    void set_pin_to_core(int core)
+    {
+        this->pin_to_core_ = core;
+    }
+
     // Set total power query ratio control parameter
     void set_power_ratio(int ratio)
     {
@@ -150,17 +768,151 @@ public:
         this->simulate_ = simulate;
     }
 
+    // Simulation load generation: emission period decoupled from the 5s task interval
+    void set_simulate_interval(uint32_t interval_ms)
+    {
+        this->simulate_interval_ms_ = interval_ms < 10 ? 10 : interval_ms;
+    }
+
+    // Seed for the simulation PRNG; the same seed reproduces the same value sequence
+    void set_simulate_seed(uint32_t seed)
+    {
+        this->simulate_seed_ = seed;
+    }
+
+    // Synthesize raw response frames and push them through the parser instead of
+    // calling the callbacks directly, so the full RX path is load-tested too
+    void set_simulate_inject_frames(bool inject)
+    {
+        this->simulate_inject_frames_ = inject;
+    }
+
+    // Set burst cycle mode (refresh all read DIs back-to-back per wakeup)
+    void set_burst_cycle(bool burst_cycle)
+    {
+        this->burst_cycle_ = burst_cycle;
+    }
+
+    // Set passive listener mode: keep parsing bus traffic between our own polls so
+    // responses solicited by other masters on a shared RS-485 bus update the cache too
+    void set_passive_listen(bool passive_listen)
+    {
+        this->passive_listen_ = passive_listen;
+    }
+
+    // Register a meter address from YAML (6 bytes BCD, LSB first).
+    // Addresses configured this way skip the broadcast discovery phase.
+    void add_meter_address(const std::vector<uint8_t>& address)
+    {
+        DLT645MeterState meter;
+        meter.address = address;
+        meter.discovered = (address.size() == 6);
+        this->meters_.push_back(meter);
+    }
+
+    // Index of the meter that produced the event currently being dispatched. Latched at
+    // parse time by the polling task and loaded per event during the main-loop drain, so
+    // trigger lambdas see the producer even after the rotation has moved on to another
+    // meter. Outside a dispatch it holds the most recently dispatched meter.
+    size_t get_active_meter_index() const
+    {
+        return this->dispatching_meter_index_;
+    }
+
     // Set max events count for event polling (called during task initialization)
     void set_max_events(size_t max_events)
     {
         this->max_events_ = max_events;
     }
 
+    // Per-channel publish deadbands: a callback is skipped when the value moved less
+    // than the deadband since the last publish (0 = publish on every parse).
+    void set_deadband_power(float watts)
+    {
+        this->deadband_power_w_ = watts;
+    }
+    void set_deadband_voltage(float volts)
+    {
+        this->deadband_voltage_v_ = volts;
+    }
+    void set_deadband_current(float amps)
+    {
+        this->deadband_current_a_ = amps;
+    }
+    void set_deadband_power_factor(float pf)
+    {
+        this->deadband_power_factor_ = pf;
+    }
+    void set_deadband_frequency(float hertz)
+    {
+        this->deadband_frequency_hz_ = hertz;
+    }
+    void set_deadband_energy(float kwh)
+    {
+        this->deadband_energy_kwh_ = kwh;
+    }
+
+    // Forced publish interval: a suppressed channel still publishes at least this often
+    void set_heartbeat_interval(uint32_t interval_ms)
+    {
+        this->heartbeat_interval_ms_ = interval_ms;
+    }
+
+    // Cap on events dispatched per loop() pass; anything beyond stays pending in
+    // the event group for the next pass, keeping per-iteration cost bounded
+    void set_event_drain_budget(int budget)
+    {
+        this->event_drain_budget_ = budget;
+    }
+
+    // Per-DI refresh interval for the deadline scheduler (request_type indexes the
+    // READ_POS_START..READ_POS_END range). Configuring any interval switches the
+    // rotation from the power_ratio heuristic to deadline-based scheduling; channels
+    // without an interval are simply not polled.
+    void set_refresh_interval(uint32_t request_type, uint32_t interval_ms)
+    {
+        if (request_type <= static_cast<uint32_t>(DLT645_REQUEST_TYPE::READ_POS_END)) {
+            this->refresh_interval_ms_[request_type] = interval_ms;
+            this->adaptive_schedule_ = true;
+        }
+    }
+
+    // On-wire telemetry: counters and latency histograms collected by the polling task.
+    // With these, slow sensor updates can be attributed to meter response time, baud
+    // mismatch or scheduler starvation instead of guessing at power_ratio_/timeouts.
+    const DLT645Stats& get_stats() const
+    {
+        return this->stats_;
+    }
+    // Take a consistent, tear-free snapshot of all cached readings in O(1).
+    // Safe to call from the main loop or any other task; never blocks the polling task.
+    DLT645MeterReadings get_meter_readings() const;
+
+    // Per-meter variant for multi-meter buses: copies the addressed meter's own record,
+    // so automations can read any meter's values regardless of the rotation position.
+    // Returns a default record for an out-of-range index.
+    DLT645MeterReadings get_meter_readings(size_t meter_index) const;
+
+    float get_bus_utilization() const; // Percentage of the accounting window spent on the wire
+    void reset_stats();                // Clear counters and start a new accounting window
+    void log_stats();                  // Dump counters and per-DI latency to the log
+
+    // Periodic diagnostic dispatch (0 = disabled); fires on_stats from the main loop
+    void set_stats_interval(uint32_t interval_ms)
+    {
+        this->stats_interval_ms_ = interval_ms;
+    }
+    void add_on_stats_callback(std::function<void(DLT645Stats)>&& callback)
+    {
+        this->stats_callback_.add(std::move(callback));
+    }
+
     // DL/T 645-2007 data identifier independent event callback functions
     void add_on_device_address_callback(std::function<void(uint32_t)>&& callback)
     {
         this->device_address_callback_.add(std::move(callback));
     }
+#ifdef DLT645_USE_ACTIVE_POWER
     void add_on_active_power_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->active_power_callback_.add(std::move(callback));
@@ -169,67 +921,249 @@ public:
     {
         this->warning_reverse_power_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_ENERGY_ACTIVE
     void add_on_energy_active_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->energy_active_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_VOLTAGE_A
     void add_on_voltage_a_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->voltage_a_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_CURRENT_A
     void add_on_current_a_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->current_a_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_POWER_FACTOR
     void add_on_power_factor_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->power_factor_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_FREQUENCY
     void add_on_frequency_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->frequency_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_ENERGY_REVERSE
     void add_on_energy_reverse_callback(std::function<void(uint32_t, float)>&& callback)
     {
         this->energy_reverse_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_DATETIME
     void add_on_datetime_callback(std::function<void(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)>&& callback)
     {
         this->datetime_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_TIME_HMS
     void add_on_time_hms_callback(std::function<void(uint32_t, uint32_t, uint32_t, uint32_t)>&& callback)
     {
         this->time_hms_callback_.add(std::move(callback));
     }
+#endif
+#ifdef DLT645_USE_RELAY_STATUS
     void add_on_relay_status_callback(std::function<void(uint32_t, uint32_t)>&& callback)
     {
         this->relay_status_callback_.add(std::move(callback));
     }
+#endif
+
+    // Generic register engine: fires once per decoded value (DI, value index, value)
+    void add_on_value_callback(std::function<void(uint32_t, uint32_t, float)>&& callback)
+    {
+        this->value_callback_.add(std::move(callback));
+    }
+
+    // Async action completion: fires once per finished control/write action
+    // (token, request type, result code — see DLT645_ACTION_RESULT)
+    void add_on_action_result_callback(std::function<void(uint32_t, uint8_t, uint8_t)>&& callback)
+    {
+        this->action_result_callback_.add(std::move(callback));
+    }
+
+    // === Native sensor platform (sensor.py / text_sensor.py) ===
+    // Entities map straight from the cached-value store; publishes are batched into one
+    // main-loop pass per event drain (see publish_batched_sensors_) instead of one
+    // scheduled publish per channel. Setters follow the channel compile-out, so wiring
+    // a sensor to a channel that is not declared in `channels:` fails at compile time.
+#ifdef USE_SENSOR
+#ifdef DLT645_USE_ACTIVE_POWER
+    void set_active_power_sensor(sensor::Sensor* sens)
+    {
+        this->active_power_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_ENERGY_ACTIVE
+    void set_energy_active_sensor(sensor::Sensor* sens)
+    {
+        this->energy_active_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_VOLTAGE_A
+    void set_voltage_a_sensor(sensor::Sensor* sens)
+    {
+        this->voltage_a_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_CURRENT_A
+    void set_current_a_sensor(sensor::Sensor* sens)
+    {
+        this->current_a_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_POWER_FACTOR
+    void set_power_factor_sensor(sensor::Sensor* sens)
+    {
+        this->power_factor_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_FREQUENCY
+    void set_frequency_sensor(sensor::Sensor* sens)
+    {
+        this->frequency_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_ENERGY_REVERSE
+    void set_energy_reverse_sensor(sensor::Sensor* sens)
+    {
+        this->energy_reverse_sensor_ = sens;
+    }
+#endif
+#endif // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+#ifdef DLT645_USE_DATETIME
+    void set_datetime_text_sensor(text_sensor::TextSensor* sens)
+    {
+        this->datetime_text_sensor_ = sens;
+    }
+#endif
+#ifdef DLT645_USE_TIME_HMS
+    void set_time_hms_text_sensor(text_sensor::TextSensor* sens)
+    {
+        this->time_hms_text_sensor_ = sens;
+    }
+#endif
+#endif // USE_TEXT_SENSOR
 
-    // DL/T 645-2007 Relay control public methods
+    // DL/T 645-2007 Relay control public methods. The bool forms only report that the
+    // request was queued; the _async forms return the completion token (0 = enqueue
+    // failed) whose wire outcome arrives via add_on_action_result_callback()
     bool relay_trip_action();  // Trip relay (open/disconnect)
     bool relay_close_action(); // Close relay (connect)
-    
+    uint32_t relay_trip_action_async();
+    uint32_t relay_close_action_async();
+
     // DL/T 645-2007 Date/Time setting public methods (DI-based write commands)
     bool set_datetime_action(); // Set meter date (WW DD MM YY format - 4 bytes, DI=0x04000101)
     bool set_time_action();     // Set meter time (HH mm SS format - 3 bytes, DI=0x04000102)
-    
+    uint32_t set_datetime_action_async();
+    uint32_t set_time_action_async(); // Queued variant of set_time_action() with completion reporting
+
     // DL/T 645-2007 Broadcast time synchronization (Control Code 0x08)
     bool broadcast_time_sync(); // Broadcast time sync (YY MM DD HH mm format - 5 bytes, C=0x08)
+    uint32_t broadcast_time_sync_async();
+
+    // Burst capture: suspend the normal rotation and issue back-to-back power queries
+    // for duration_ms (capped by the sample buffer). Returns false when a capture is
+    // already running or the polling task is down. The batch arrives through
+    // add_on_burst_capture_callback(); samples stay readable via
+    // get_burst_capture_samples() until the next capture starts.
+    bool start_burst_capture(uint32_t duration_ms);
+    void add_on_burst_capture_callback(std::function<void(uint32_t)>&& callback)
+    {
+        this->burst_capture_callback_.add(std::move(callback));
+    }
+    const std::vector<DLT645BurstSample>& get_burst_capture_samples() const
+    {
+        return this->burst_samples_;
+    }
+
+    // One-shot duty-cycle mode for deep-sleep installs: on boot the polling task
+    // restores the cached identity, runs the configured readings once back-to-back,
+    // signals completion (so YAML can enter deep sleep) and exits. No rotation,
+    // no periodic polling.
+    void set_one_shot_mode(bool one_shot)
+    {
+        this->one_shot_mode_ = one_shot;
+    }
+    void add_one_shot_reading(uint32_t request_type)
+    {
+        this->one_shot_readings_.push_back(static_cast<enum DLT645_REQUEST_TYPE>(request_type));
+    }
+    void add_on_one_shot_complete_callback(std::function<void(uint32_t)>&& callback)
+    {
+        this->one_shot_complete_callback_.add(std::move(callback));
+    }
 
 protected:
     // FreeRTOS task related methods
     bool create_dlt645_task();
     void destroy_dlt645_task();
     static void dlt645_task_func(void* parameter);
+    static void dlt645_rx_task_func(void* parameter); // Minimal UART drain stage (small stack)
     void process_dlt645_events();
 
+#if defined(USE_ESP32) || defined(USE_ESP_IDF)
+    // Execute a single DL/T 645 request (build/send frame, then receive and parse the
+    // response), retrying idempotent reads in-cycle on timeout or checksum failure
+    void execute_dlt645_request(enum DLT645_REQUEST_TYPE request_type);
+    // One attempt, no retry; returns whether the request frame made it onto the wire
+    bool execute_dlt645_request_once_(enum DLT645_REQUEST_TYPE request_type);
+
+    // Multi-meter scheduling: rotate the active meter and keep its learned state in the table
+    void select_next_meter_();
+    void sync_active_meter_state_();
+
+    // Queue a user-initiated control/write request on the priority lane and wake the task;
+    // returns the completion token for the queued action (0 = queue full or missing)
+    uint32_t enqueue_priority_request_(enum DLT645_REQUEST_TYPE request);
+
+    // Hand a finished action outcome from the polling task to the main loop
+    void complete_action_(uint32_t token, enum DLT645_REQUEST_TYPE request, DLT645_ACTION_RESULT result);
+
+#if defined(USE_SENSOR) || defined(USE_TEXT_SENSOR)
+    // One batched publish pass per event drain: pushes every entity whose channel
+    // changed since the last drain straight from the cached-value store
+    void publish_batched_sensors_();
+#endif
+
+    // Passive listener: drain and parse unsolicited bus traffic for up to window_ms
+    void listen_for_unsolicited_frames_(uint32_t window_ms);
+
+    // Bounded-latency supervision: the polling task registers with the ESP task
+    // watchdog, long idle waits are sliced so the feed cadence is kept, and every
+    // transaction carries a deadline derived from baud rate and worst-case frame time
+    void feed_task_watchdog_();                   // Reset the WDT if the task is subscribed
+    bool idle_wait_notified_(uint32_t wait_ms);   // Interruptible sleep in WDT-fed slices; true = priority wake
+    uint32_t response_budget_ms_() const;         // Worst-case response wire time at the current rate
+
+    // Burst capture worker: runs on the polling task in place of one rotation pass
+    void run_burst_capture_();
+
+    // One-shot measurement pass: runs once on the polling task, then the task exits
+    void run_one_shot_cycle_();
+#endif
+
     // === DL/T 645-2007 UART communication related methods ===
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
     bool init_dlt645_uart();   // UART initialization
     void deinit_dlt645_uart(); // UART deinitialization
-    bool send_dlt645_frame(const std::vector<uint8_t>& frame,
-                           uint32_t timeout_ms = 1000); // Send frame (with configurable timeout)
+    // Send frame (with configurable timeout). The pointer/length form is the core;
+    // the vector overload forwards for callers still holding an owned frame.
+    bool send_dlt645_frame(const uint8_t* frame_data, size_t frame_length, uint32_t timeout_ms = 1000);
+    bool send_dlt645_frame(const std::vector<uint8_t>& frame, uint32_t timeout_ms = 1000)
+    {
+        return this->send_dlt645_frame(frame.data(), frame.size(), timeout_ms);
+    }
     void process_uart_data();                           // Process UART data
     void check_and_parse_dlt645_frame();                // Check and parse DL/T 645 frame
 
@@ -237,6 +1171,23 @@ protected:
     bool change_uart_baud_rate(int new_baud_rate); // Switch UART baud rate
     void cycle_to_next_baud_rate();                // Cycle to next baud rate
 
+    // Hardware-timer inter-frame pacing: arm a one-shot esp_timer for the
+    // protocol gap and block on a task notification instead of tick-granular vTaskDelay
+    uint32_t inter_frame_gap_us_() const; // Protocol-required gap derived from current baud rate
+    void wait_inter_frame_gap_();         // Arm gap timer and block until it fires (or a priority wake)
+    static void gap_timer_callback_(void* arg);
+
+    // Fast baud discovery helpers
+    uint32_t discovery_probe_timeout_ms_() const; // Probe timeout from wire time at current rate
+    void load_learned_baud_rate_();               // Restore last working rate from preferences
+    void save_learned_baud_rate_();               // Persist current rate after successful discovery
+
+    // Warm-boot identity cache: address + rate restored from preferences so polling
+    // starts immediately; broadcast discovery is demoted to a fallback that only
+    // runs if the cached address never answers
+    void load_cached_meter_address_(); // Restore last confirmed address from preferences
+    void save_cached_meter_address_(); // Persist the address once confirmed on the wire
+
     // DL/T 645-2007 frame building and data processing helper functions
     std::vector<uint8_t> build_dlt645_read_frame(const std::vector<uint8_t>& address, uint32_t data_identifier);
     std::vector<uint8_t> build_dlt645_write_frame(const std::vector<uint8_t>& address, uint32_t data_identifier, 
@@ -251,6 +1202,18 @@ protected:
     bool query_active_power_total();                                                                        // Query total power
     void parse_dlt645_data_by_identifier(uint32_t data_identifier, const std::vector<uint8_t>& data_field); // Parse data by DI
 
+    // Generic register engine: decode a YAML-declared DI (returns false when the DI
+    // is not a custom register) and poll the entries whose interval has elapsed
+    bool parse_custom_register_(uint32_t data_identifier, const std::vector<uint8_t>& actual_data);
+    void poll_due_custom_registers_(bool force_all);
+
+    // Table-driven decode for numeric DIs (see DLT645_DI_DESCRIPTORS)
+    void parse_numeric_di_(const DLT645DiDescriptor& desc, const std::vector<uint8_t>& actual_data);
+    float* cached_slot_(DLT645_DATA_IDENTIFIER di);  // Cached-value slot for a numeric DI
+    float* meter_slot_(DLT645MeterReadings& readings, DLT645_DATA_IDENTIFIER di); // Per-meter record slot
+    void set_di_event_(EventBits_t bit);             // Latch the producing meter, then raise the event
+    void detect_reverse_power_(float power_w);       // Reverse power transition warning
+
     // DL/T 645-2007 relay control frame building (protected helper)
     std::vector<uint8_t> build_dlt645_relay_control_frame(const std::vector<uint8_t>& address, bool close_relay);
     
@@ -264,6 +1227,15 @@ protected:
     
     // Simulation mode helper
     void simulate_measurements_();  // Generate simulated meter readings
+
+    // Simulation load generation helpers
+    uint32_t sim_rand_();                                // xorshift32, seeded from simulate_seed_
+    float sim_rand_range_(float min_value, float max_value);
+#if defined(USE_ESP32) || defined(USE_ESP_IDF)
+    // Encode a value as a scrambled 0x91 response frame and feed it through the
+    // real RX parser (check_and_parse_dlt645_frame)
+    void inject_simulated_frame_(const DLT645DiDescriptor& desc, float value);
+#endif
     
     // Event polling state (private - cannot be accessed directly from outside)
     size_t max_events_{0};           // Maximum number of events (set during task initialization)
@@ -273,6 +1245,31 @@ private:
     enum DLT645_REQUEST_TYPE current_request_type{DLT645_REQUEST_TYPE::READ_DEVICE_ADDRESS};
     
 protected:
+    // Delta suppression: check deadband and heartbeat, record the publish when it passes
+    bool should_publish_(DLT645PublishState& state, float value, float deadband);
+
+    // Seqlock writer: copy the cached_* fields into the shared snapshot (polling task only)
+    void update_readings_snapshot_();
+
+    // Publish deadbands (0 = disabled) and forced heartbeat interval
+    float deadband_power_w_{0.0f};
+    float deadband_voltage_v_{0.0f};
+    float deadband_current_a_{0.0f};
+    float deadband_power_factor_{0.0f};
+    float deadband_frequency_hz_{0.0f};
+    float deadband_energy_kwh_{0.0f};
+    uint32_t heartbeat_interval_ms_{60000};
+    int event_drain_budget_{4}; // Max events dispatched per loop() pass
+
+    // Last-published value tracking lives per meter in DLT645MeterState (deadbands must
+    // compare against the same meter's previous publish, not the bus-wide latest)
+
+    // Deadline scheduler: per read request type refresh interval and next-due timestamp.
+    // Indexed by DLT645_REQUEST_TYPE value; 0 interval means the channel is not polled.
+    uint32_t refresh_interval_ms_[static_cast<size_t>(DLT645_REQUEST_TYPE::READ_POS_END) + 1]{};
+    uint32_t next_due_ms_[static_cast<size_t>(DLT645_REQUEST_TYPE::READ_POS_END) + 1]{};
+    bool adaptive_schedule_{false};
+
     // Query ratio control
     int power_ratio_{10};
     int total_power_query_count_{0};
@@ -281,43 +1278,159 @@ protected:
     
     // Simulation mode
     bool simulate_{false};
+    uint32_t simulate_interval_ms_{DLT645_TRIGGER_INTERVAL_MS}; // Emission period (load generation)
+    uint32_t simulate_seed_{0x645645u};                         // PRNG seed (deterministic replay)
+    uint32_t simulate_rng_state_{0};                            // xorshift32 state, seeded on first use
+    bool simulate_inject_frames_{false};                        // Exercise the parser with synthesized frames
+    float simulate_energy_kwh_{0.0f};                           // Accumulated forward energy
+    float simulate_energy_reverse_kwh_{0.0f};                   // Accumulated reverse energy
+
+    // Burst cycle mode: walk the whole read rotation back-to-back per wakeup
+    bool burst_cycle_{false};
+
+    // Passive listener mode: parse shared-bus traffic while idle
+    bool passive_listen_{false};
 
     // DL/T 645-2007 event callbacks
-    CallbackManager<void(uint32_t)> device_address_callback_;      // Device address
+    CallbackManager<void(uint32_t)> device_address_callback_; // Device address
+#ifdef DLT645_USE_ACTIVE_POWER
     CallbackManager<void(uint32_t, float)> active_power_callback_; // Total active power
     CallbackManager<void(uint32_t, float)>
-        warning_reverse_power_callback_;                             // Reverse power warning (triggers only on >=0 to <0 transition)
-    CallbackManager<void(uint32_t, float)> energy_active_callback_;  // Total active energy
-    CallbackManager<void(uint32_t, float)> voltage_a_callback_;      // Phase A voltage
-    CallbackManager<void(uint32_t, float)> current_a_callback_;      // Phase A current
-    CallbackManager<void(uint32_t, float)> power_factor_callback_;   // Power factor
-    CallbackManager<void(uint32_t, float)> frequency_callback_;      // Grid frequency
+        warning_reverse_power_callback_; // Reverse power warning (triggers only on >=0 to <0 transition)
+#endif
+#ifdef DLT645_USE_ENERGY_ACTIVE
+    CallbackManager<void(uint32_t, float)> energy_active_callback_; // Total active energy
+#endif
+#ifdef DLT645_USE_VOLTAGE_A
+    CallbackManager<void(uint32_t, float)> voltage_a_callback_; // Phase A voltage
+#endif
+#ifdef DLT645_USE_CURRENT_A
+    CallbackManager<void(uint32_t, float)> current_a_callback_; // Phase A current
+#endif
+#ifdef DLT645_USE_POWER_FACTOR
+    CallbackManager<void(uint32_t, float)> power_factor_callback_; // Power factor
+#endif
+#ifdef DLT645_USE_FREQUENCY
+    CallbackManager<void(uint32_t, float)> frequency_callback_; // Grid frequency
+#endif
+#ifdef DLT645_USE_ENERGY_REVERSE
     CallbackManager<void(uint32_t, float)> energy_reverse_callback_; // Reverse active energy
+#endif
+#ifdef DLT645_USE_DATETIME
     CallbackManager<void(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)>
         datetime_callback_; // Date and time (DI, year, month, day, weekday)
+#endif
+#ifdef DLT645_USE_TIME_HMS
     CallbackManager<void(uint32_t, uint32_t, uint32_t, uint32_t)>
         time_hms_callback_; // Time HMS (DI, hour, minute, second)
+#endif
+#ifdef DLT645_USE_RELAY_STATUS
     CallbackManager<void(uint32_t, uint32_t)>
         relay_status_callback_; // Relay status (DI, status: 0=closed, 1=open, 2=fault)
+#endif
+    CallbackManager<void(uint32_t, uint32_t, float)>
+        value_callback_; // Generic register engine (DI, value index, value)
+    CallbackManager<void(uint32_t, uint8_t, uint8_t)>
+        action_result_callback_; // Async action completion (token, request type, result)
+    CallbackManager<void(uint32_t)>
+        burst_capture_callback_; // Burst capture window closed (sample count)
+    CallbackManager<void(uint32_t)>
+        one_shot_complete_callback_; // One-shot pass finished (successful reading count)
+
+    // YAML-declared registers beyond the built-in channels (generic register engine)
+    std::vector<DLT645CustomRegister> custom_registers_;
+
+    // Native sensor platform entities (nullptr unless configured under sensor:/text_sensor:)
+#ifdef USE_SENSOR
+#ifdef DLT645_USE_ACTIVE_POWER
+    sensor::Sensor* active_power_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_ENERGY_ACTIVE
+    sensor::Sensor* energy_active_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_VOLTAGE_A
+    sensor::Sensor* voltage_a_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_CURRENT_A
+    sensor::Sensor* current_a_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_POWER_FACTOR
+    sensor::Sensor* power_factor_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_FREQUENCY
+    sensor::Sensor* frequency_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_ENERGY_REVERSE
+    sensor::Sensor* energy_reverse_sensor_{nullptr};
+#endif
+#endif // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+#ifdef DLT645_USE_DATETIME
+    text_sensor::TextSensor* datetime_text_sensor_{nullptr};
+#endif
+#ifdef DLT645_USE_TIME_HMS
+    text_sensor::TextSensor* time_hms_text_sensor_{nullptr};
+#endif
+#endif // USE_TEXT_SENSOR
 
     // FreeRTOS
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
     TaskHandle_t dlt645_task_handle_{nullptr};
+    TaskHandle_t dlt645_rx_task_handle_{nullptr}; // RX/byte-drain stage feeding the parse task
     EventGroupHandle_t event_group_{nullptr};
     QueueHandle_t request_queue_{nullptr};
+    QueueHandle_t rx_chunk_queue_{nullptr}; // Byte batches: RX task -> frame assembly/parse
+    QueueHandle_t control_queue_{nullptr}; // Priority lane: control/write requests preempt the read rotation
+    QueueHandle_t action_result_queue_{nullptr}; // Completed action outcomes, polling task -> main loop
     bool task_running_{false};
+    bool wdt_subscribed_{false}; // Polling task registered with the ESP task watchdog
+
+    // Async action completion bookkeeping. The token counter lives on the enqueueing
+    // side (main loop); the pending pair is only touched by the polling task between
+    // dequeuing a control request and classifying its outcome.
+    uint32_t next_action_token_{0};                                   // Last issued token (pre-incremented)
+    uint32_t pending_action_token_{0};                                // Token of the control request in flight
+    DLT645_REQUEST_TYPE pending_action_request_{};                    // Request type the token belongs to
+    uint32_t control_acks_{0}; // Acknowledgment frames (0x9C/0x94/0x88) seen on the wire
+
+    // Burst capture state. The request field is the handoff: the main loop stores the
+    // window length and the polling task consumes it; samples are only written while
+    // the capture is active and only read after the completion event fires.
+    std::vector<DLT645BurstSample> burst_samples_;
+    uint32_t burst_capture_request_ms_{0}; // Pending window length (0 = none requested)
+    bool burst_capture_active_{false};     // Polling task is inside a capture window
+
+    // One-shot duty-cycle mode: configured DI list, success count for the completion
+    // event. The readings run once on the polling task right after setup, then it exits.
+    bool one_shot_mode_{false};
+    std::vector<enum DLT645_REQUEST_TYPE> one_shot_readings_;
+    uint32_t one_shot_ok_count_{0};
+
+    // Channels that changed since the last batched entity publish, keyed by the same
+    // EVENT_DI_* bits as the event group. Main-loop only: set during the event drain,
+    // cleared by publish_batched_sensors_().
+    EventBits_t sensor_dirty_bits_{0};
+
+    // Task tuning (YAML-overridable); defaults sized from measured stack high-water marks
+    uint32_t task_stack_size_{DLT645_TASK_STACK_SIZE};
+    uint32_t rx_task_stack_size_{DLT645_RX_TASK_STACK_SIZE};
+    uint8_t task_priority_{DLT645_TASK_PRIORITY};
+    int pin_to_core_{-1}; // Core affinity for both tasks (-1 = no pinning)
 #endif
 
     // === DL/T 645-2007 UART ===
 
     int dlt645_tx_pin_{1};
     int dlt645_rx_pin_{2};
+    int dlt645_de_pin_{-1}; // RS-485 DE/RE via RTS, -1 = not used
     int dlt645_baud_rate_{2400};
     int dlt645_rx_buffer_size_{256};
 
 #if defined(USE_ESP32) || defined(USE_ESP_IDF)
-    uart_port_t uart_port_{UART_NUM_1}; // UART1
-    bool uart_initialized_{false};      // UART initialization
+    uart_port_t uart_port_{UART_NUM_1};      // UART1
+    bool uart_initialized_{false};           // UART initialization
+    QueueHandle_t uart_event_queue_{nullptr}; // UART driver event queue (owned by driver, event-driven RX)
+    esp_timer_handle_t gap_timer_{nullptr};   // One-shot inter-frame gap timer (µs resolution)
 #endif
 
     // （YAMLglobals）
@@ -325,8 +1438,27 @@ protected:
     std::vector<uint8_t> broadcast_address_bytes_; //
     bool device_address_discovered_{false};        //
 
+    // Multi-meter table: scheduler round-robins through these on one bus.
+    // Empty or single entry keeps the original single-meter behavior.
+    std::vector<DLT645MeterState> meters_;
+    size_t current_meter_index_{0};
+
+    // Producing meter latched per event bit at parse time (indexed by bit position, see
+    // set_di_event_). The main-loop drain reads the latch when it dispatches that event,
+    // so attribution survives the rotation moving on and budget-deferred dispatch.
+    // Single-byte relaxed handoff, same discipline as the cached readings.
+    uint8_t event_meter_index_[16]{};
+    size_t dispatching_meter_index_{0}; // Main loop: meter of the event being dispatched
+
     // UART（YAML）
-    std::vector<uint8_t> response_buffer_;       //
+    DLT645RxRing rx_ring_;                       // Fixed-capacity RX frame assembler (allocated once in setup)
+    DLT645FlightRecorder flight_recorder_;       // Binary TX/RX frame event ring (flight recorder)
+    int flight_recorder_size_{0};                // Ring size in bytes (0 = recorder disabled)
+    // TX staging buffer: DL/T 645 command frames are bounded (~40 bytes with preamble),
+    // so the steady-state poll path formats into this fixed array instead of allocating
+    // a fresh vector per frame (transient frame vectors were the main heap fragmentation
+    // driver in long-uptime traces)
+    std::array<uint8_t, 64> tx_frame_buf_{};
     uint32_t last_data_receive_time_{0};         //
     uint32_t current_command_timeout_ms_{1000};  // (waiting_for_response_)
     uint32_t frame_timeout_ms_{1000};            // (1)
@@ -339,11 +1471,26 @@ protected:
     // （）
     std::vector<int> baud_rate_list_{1200, 2400, 4800, 9600}; // ，
     size_t current_baud_rate_index_{0};                       //
+    bool fast_baud_discovery_{true};                          // Short probe timeouts + learned rate ordering
+    ESPPreferenceObject baud_rate_pref_;                      // Last working rate, survives reboots
+    ESPPreferenceObject meter_address_pref_;                  // Last confirmed meter address, survives reboots
+    bool cached_address_unverified_{false};                   // Restored from cache but not yet confirmed this boot
+    uint8_t max_retries_{2};                                  // In-cycle retry budget for failed reads
 
     //
     uint32_t command_send_start_time_{0};
     uint32_t first_response_byte_time_{0};
 
+    // On-wire telemetry (single writer: the polling task). The RX task runs at higher
+    // priority and possibly on another core, so its overflow counter lives in an atomic
+    // that the polling task folds into stats_.rx_overflows instead of the RX task
+    // touching the struct directly.
+    DLT645Stats stats_;
+    std::atomic<uint32_t> rx_overflow_count_{0}; // Written by the RX task only
+    uint32_t stats_interval_ms_{0};      // 0 = no periodic diagnostic dispatch
+    uint32_t last_stats_dispatch_ms_{0}; // Main-loop timestamp of the last on_stats fire
+    CallbackManager<void(DLT645Stats)> stats_callback_;
+
     // === DL/T 645（）===
     // FreeRTOS，ESPHome
     float cached_active_power_w_{0.0f};     //  (W)
@@ -353,6 +1500,12 @@ protected:
     float cached_power_factor_{0.0f};       //
     float cached_frequency_hz_{0.0f};       //  (Hz)
     float cached_energy_reverse_kwh_{0.0f}; //  (kWh)
+
+    // Shared snapshot store: written by the polling task via update_readings_snapshot_(),
+    // read tear-free from any context through get_meter_readings(). An odd sequence
+    // number means a write is in progress.
+    DLT645MeterReadings readings_snapshot_;
+    std::atomic<uint32_t> readings_seq_{0};
     std::string cached_datetime_str_{""};   // Date string
     std::string cached_time_hms_str_{""};   // Time HMS string
 
@@ -385,6 +1538,7 @@ public:
     }
 };
 
+#ifdef DLT645_USE_ACTIVE_POWER
 class ActivePowerTrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -406,7 +1560,9 @@ public:
         });
     }
 };
+#endif
 
+#ifdef DLT645_USE_ENERGY_ACTIVE
 class EnergyActiveTrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -416,7 +1572,9 @@ public:
             [this](uint32_t data_identifier, float energy_kwh) { this->trigger(data_identifier, energy_kwh); });
     }
 };
+#endif
 
+#ifdef DLT645_USE_VOLTAGE_A
 class VoltageATrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -426,7 +1584,9 @@ public:
             [this](uint32_t data_identifier, float voltage_v) { this->trigger(data_identifier, voltage_v); });
     }
 };
+#endif
 
+#ifdef DLT645_USE_CURRENT_A
 class CurrentATrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -436,7 +1596,9 @@ public:
             [this](uint32_t data_identifier, float current_a) { this->trigger(data_identifier, current_a); });
     }
 };
+#endif
 
+#ifdef DLT645_USE_POWER_FACTOR
 class PowerFactorTrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -446,7 +1608,9 @@ public:
             [this](uint32_t data_identifier, float power_factor) { this->trigger(data_identifier, power_factor); });
     }
 };
+#endif
 
+#ifdef DLT645_USE_FREQUENCY
 class FrequencyTrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -456,7 +1620,9 @@ public:
             [this](uint32_t data_identifier, float frequency_hz) { this->trigger(data_identifier, frequency_hz); });
     }
 };
+#endif
 
+#ifdef DLT645_USE_ENERGY_REVERSE
 class EnergyReverseTrigger : public Trigger<uint32_t, float>
 {
 public:
@@ -467,7 +1633,9 @@ public:
         });
     }
 };
+#endif
 
+#ifdef DLT645_USE_DATETIME
 class DatetimeTrigger : public Trigger<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>
 {
 public:
@@ -479,7 +1647,9 @@ public:
             });
     }
 };
+#endif
 
+#ifdef DLT645_USE_TIME_HMS
 class TimeHmsTrigger : public Trigger<uint32_t, uint32_t, uint32_t, uint32_t>
 {
 public:
@@ -491,7 +1661,9 @@ public:
             });
     }
 };
+#endif
 
+#ifdef DLT645_USE_RELAY_STATUS
 class RelayStatusTrigger : public Trigger<uint32_t, uint32_t>
 {
 public:
@@ -503,6 +1675,67 @@ public:
             });
     }
 };
+#endif
+
+// Generic register engine: one trigger for every YAML-declared DI; block reads
+// fire once per packed value with its index
+class ValueTrigger : public Trigger<uint32_t, uint32_t, float>
+{
+public:
+    explicit ValueTrigger(DLT645Component* parent)
+    {
+        parent->add_on_value_callback(
+            [this](uint32_t data_identifier, uint32_t index, float value) {
+                this->trigger(data_identifier, index, value);
+            });
+    }
+};
+
+// Async action completion: fires when a queued control/write action finishes on the
+// wire — acknowledged, rejected, timed out, or never sent (see DLT645_ACTION_RESULT)
+class ActionResultTrigger : public Trigger<uint32_t, uint8_t, uint8_t>
+{
+public:
+    explicit ActionResultTrigger(DLT645Component* parent)
+    {
+        parent->add_on_action_result_callback(
+            [this](uint32_t token, uint8_t request, uint8_t result) {
+                this->trigger(token, request, result);
+            });
+    }
+};
+
+// Burst capture completion: fires once per closed window with the sample count; the
+// samples themselves stay readable through get_burst_capture_samples()
+class BurstCaptureTrigger : public Trigger<uint32_t>
+{
+public:
+    explicit BurstCaptureTrigger(DLT645Component* parent)
+    {
+        parent->add_on_burst_capture_callback([this](uint32_t sample_count) { this->trigger(sample_count); });
+    }
+};
+
+// One-shot pass finished: fires once per boot with the number of readings that got a
+// valid response - the YAML hook point for entering deep sleep
+class OneShotCompleteTrigger : public Trigger<uint32_t>
+{
+public:
+    explicit OneShotCompleteTrigger(DLT645Component* parent)
+    {
+        parent->add_on_one_shot_complete_callback([this](uint32_t ok_count) { this->trigger(ok_count); });
+    }
+};
+
+// Periodic diagnostic snapshot of the on-wire telemetry counters
+class StatsTrigger : public Trigger<DLT645Stats>
+{
+public:
+    explicit StatsTrigger(DLT645Component* parent)
+    {
+        parent->add_on_stats_callback([this](DLT645Stats stats) { this->trigger(stats); });
+    }
+};
 
 // DL/T 645-2007 继电器控制 Actions
 template<typename... Ts> class RelayTripAction : public Action<Ts...>
@@ -562,6 +1795,42 @@ protected:
     DLT645Component* parent_;
 };
 
+// Flight recorder: dump the captured frame ring as replayable log lines
+template<typename... Ts> class DumpFlightRecorderAction : public Action<Ts...>
+{
+public:
+    DumpFlightRecorderAction(DLT645Component* parent) : parent_(parent) {}
+
+    void play(Ts... x) override
+    {
+        this->parent_->dump_flight_recorder();
+    }
+
+protected:
+    DLT645Component* parent_;
+};
+
+// Burst capture: start a high-frequency power sampling window
+template<typename... Ts> class BurstCaptureAction : public Action<Ts...>
+{
+public:
+    BurstCaptureAction(DLT645Component* parent) : parent_(parent) {}
+
+    void set_duration(uint32_t duration_ms)
+    {
+        this->duration_ms_ = duration_ms;
+    }
+
+    void play(Ts... x) override
+    {
+        this->parent_->start_burst_capture(this->duration_ms_);
+    }
+
+protected:
+    DLT645Component* parent_;
+    uint32_t duration_ms_{30000};
+};
+
 // DL/T 645-2007 Broadcast Time Synchronization Action (Control Code 0x08)
 template<typename... Ts> class BroadcastTimeSyncAction : public Action<Ts...>
 {
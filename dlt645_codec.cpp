@@ -0,0 +1,258 @@
+#include "dlt645_codec.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace dlt645_component {
+namespace codec {
+
+uint8_t checksum(const uint8_t* data, size_t length)
+{
+    uint8_t sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+void scramble(std::vector<uint8_t>& data)
+{
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] += SCRAMBLE_OFFSET;
+    }
+}
+
+void unscramble(std::vector<uint8_t>& data)
+{
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] -= SCRAMBLE_OFFSET;
+    }
+}
+
+float bcd_to_float(const std::vector<uint8_t>& bcd_data, int decimal_places, bool* invalid)
+{
+    if (invalid != nullptr) {
+        *invalid = false;
+    }
+
+    uint32_t int_value = 0;
+    uint32_t multiplier = 1;
+
+    for (size_t i = 0; i < bcd_data.size(); i++) {
+        uint8_t low_nibble = bcd_data[i] & 0x0F;
+        uint8_t high_nibble = (bcd_data[i] >> 4) & 0x0F;
+
+        // Invalid BCD check
+        if (low_nibble > 9 || high_nibble > 9) {
+            if (invalid != nullptr) {
+                *invalid = true;
+            }
+            return 0.0f;
+        }
+
+        int_value += low_nibble * multiplier;
+        multiplier *= 10;
+        int_value += high_nibble * multiplier;
+        multiplier *= 10;
+    }
+
+    return (float)int_value / pow(10, decimal_places);
+}
+
+float bcd_to_float_with_sign(const std::vector<uint8_t>& bcd_data, int decimal_places, bool* invalid)
+{
+    if (bcd_data.empty()) {
+        if (invalid != nullptr) {
+            *invalid = true;
+        }
+        return 0.0f;
+    }
+
+    // Check sign bit (highest bit of last byte)
+    bool is_negative = (bcd_data.back() & 0x80) != 0;
+
+    std::vector<uint8_t> clean_bcd_data = bcd_data;
+    clean_bcd_data.back() &= 0x7F; // Clear sign bit
+
+    float result = bcd_to_float(clean_bcd_data, decimal_places, invalid);
+
+    return is_negative ? -result : result;
+}
+
+size_t build_read_frame(const uint8_t* address, size_t address_length, uint32_t data_identifier, uint8_t* out,
+                        size_t capacity)
+{
+    // 2 preamble + header + 4-byte DI + checksum + end
+    const size_t frame_length = 2 + FRAME_HEADER_LENGTH + 4 + 2;
+    if (capacity < frame_length) {
+        return 0;
+    }
+
+    size_t pos = 0;
+
+    // 1. Preamble (0xFE) - Protocol Section 7.1.1
+    // Purpose: Wake up receiver and prepare for data reception (optional, 0-4 bytes)
+    out[pos++] = FRAME_PREAMBLE;
+    out[pos++] = FRAME_PREAMBLE;
+
+    // 2. Start delimiter (0x68) - Protocol Section 7.1.2
+    out[pos++] = FRAME_START;
+
+    // 3. Address field A0-A5 (6 bytes) - BCD format, low byte first
+    for (size_t i = 0; i < FRAME_ADDRESS_LENGTH; i++) {
+        out[pos++] = i < address_length ? address[i] : 0x00;
+    }
+
+    // 4. Second start delimiter (0x68)
+    out[pos++] = FRAME_START;
+
+    // 5. Control code C: 0x11 = Master station read data command
+    out[pos++] = 0x11;
+
+    // 6. Data length L: fixed at 4 for read data command (data identifier length)
+    out[pos++] = 0x04;
+
+    // 7. Data field: DI0-DI3 (LSB first), each byte scrambled with +0x33
+    out[pos++] = ((data_identifier) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 8) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 16) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 24) & 0xFF) + SCRAMBLE_OFFSET;
+
+    // 8. Checksum CS: from the first 0x68 (skip the 2 preamble bytes)
+    out[pos] = checksum(out + 2, pos - 2);
+    pos++;
+
+    // 9. End delimiter (0x16)
+    out[pos++] = FRAME_END;
+
+    return pos;
+}
+
+size_t build_write_frame(const uint8_t* address, size_t address_length, uint32_t data_identifier,
+                         const uint8_t* write_data, size_t data_length, uint8_t* out, size_t capacity)
+{
+    // 4 preamble + header + DI + payload + checksum + end
+    const size_t frame_length = 4 + FRAME_HEADER_LENGTH + 4 + data_length + 2;
+    if (capacity < frame_length || 4 + data_length > FRAME_MAX_DATA_LENGTH) {
+        return 0;
+    }
+
+    size_t pos = 0;
+
+    // 1. Preamble (0xFE) - Wake up receiver
+    for (int i = 0; i < 4; i++) {
+        out[pos++] = FRAME_PREAMBLE;
+    }
+
+    // 2. Start delimiter (0x68)
+    out[pos++] = FRAME_START;
+
+    // 3. Address field (6 bytes)
+    for (size_t i = 0; i < FRAME_ADDRESS_LENGTH; i++) {
+        out[pos++] = i < address_length ? address[i] : 0x00;
+    }
+
+    // 4. Second start delimiter (0x68)
+    out[pos++] = FRAME_START;
+
+    // 5. Control code: 0x14 (Write data command)
+    out[pos++] = 0x14;
+
+    // 6. Data length: 4 bytes (DI) + payload length
+    out[pos++] = static_cast<uint8_t>(4 + data_length);
+
+    // 7. Data field (scrambled with +0x33): DI0-DI3 then the payload
+    out[pos++] = ((data_identifier) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 8) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 16) & 0xFF) + SCRAMBLE_OFFSET;
+    out[pos++] = ((data_identifier >> 24) & 0xFF) + SCRAMBLE_OFFSET;
+    for (size_t i = 0; i < data_length; i++) {
+        out[pos++] = write_data[i] + SCRAMBLE_OFFSET;
+    }
+
+    // 8. Checksum CS: from the first 0x68 (skip the 4 preamble bytes)
+    out[pos] = checksum(out + 4, pos - 4);
+    pos++;
+
+    // 9. End delimiter (0x16)
+    out[pos++] = FRAME_END;
+
+    return pos;
+}
+
+std::vector<uint8_t> build_read_frame(const std::vector<uint8_t>& address, uint32_t data_identifier)
+{
+    std::vector<uint8_t> frame(2 + FRAME_HEADER_LENGTH + 4 + 2);
+    size_t length = build_read_frame(address.data(), address.size(), data_identifier, frame.data(), frame.size());
+    frame.resize(length);
+    return frame;
+}
+
+std::vector<uint8_t> build_write_frame(const std::vector<uint8_t>& address, uint32_t data_identifier,
+                                       const std::vector<uint8_t>& write_data)
+{
+    std::vector<uint8_t> frame(4 + FRAME_HEADER_LENGTH + 4 + write_data.size() + 2);
+    size_t length = build_write_frame(address.data(), address.size(), data_identifier, write_data.data(),
+                                      write_data.size(), frame.data(), frame.size());
+    frame.resize(length);
+    return frame;
+}
+
+ParseResult parse_frame(const uint8_t* buf, size_t length, ParsedFrame& out, size_t& consumed)
+{
+    consumed = 0;
+
+    // Skip wakeup preamble bytes
+    size_t offset = 0;
+    while (offset < length && buf[offset] == FRAME_PREAMBLE) {
+        offset++;
+    }
+
+    if (offset >= length) {
+        return ParseResult::NEED_MORE_DATA; // Only preamble so far
+    }
+
+    if (buf[offset] != FRAME_START) {
+        return ParseResult::BAD_START;
+    }
+
+    if (length - offset < FRAME_HEADER_LENGTH) {
+        return ParseResult::NEED_MORE_DATA;
+    }
+
+    const uint8_t* frame = buf + offset;
+
+    if (frame[7] != FRAME_START) {
+        return ParseResult::BAD_SECOND_START;
+    }
+
+    uint8_t data_length = frame[9];
+    size_t frame_total_length = FRAME_HEADER_LENGTH + data_length + 2; // + checksum + end
+
+    if (length - offset < frame_total_length) {
+        return ParseResult::NEED_MORE_DATA;
+    }
+
+    if (frame[frame_total_length - 1] != FRAME_END) {
+        return ParseResult::BAD_END;
+    }
+
+    uint8_t calculated_checksum = checksum(frame, FRAME_HEADER_LENGTH + data_length);
+    if (calculated_checksum != frame[FRAME_HEADER_LENGTH + data_length]) {
+        return ParseResult::BAD_CHECKSUM;
+    }
+
+    for (size_t i = 0; i < FRAME_ADDRESS_LENGTH; i++) {
+        out.address[i] = frame[1 + i];
+    }
+    out.control_code = frame[8];
+    out.data.assign(frame + FRAME_HEADER_LENGTH, frame + FRAME_HEADER_LENGTH + data_length);
+    unscramble(out.data);
+
+    consumed = offset + frame_total_length;
+    return ParseResult::OK;
+}
+
+} // namespace codec
+} // namespace dlt645_component
+} // namespace esphome
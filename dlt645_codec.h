@@ -0,0 +1,92 @@
+#pragma once
+
+// DL/T 645-2007 frame codec: frame building, structural parsing, checksum, BCD
+// conversion and data scrambling, with no dependency on ESP-IDF, FreeRTOS or the
+// ESPHome core. This unit compiles unchanged on the host so the protocol code can
+// be unit-tested, benchmarked and fuzzed without flashing hardware (see
+// tests/host/), while the component delegates to it on target.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace dlt645_component {
+namespace codec {
+
+// Frame layout constants (DL/T 645-2007 Section 7.1)
+constexpr uint8_t FRAME_PREAMBLE = 0xFE;      // Optional wakeup bytes before the frame
+constexpr uint8_t FRAME_START = 0x68;         // Start delimiter (appears twice)
+constexpr uint8_t FRAME_END = 0x16;           // End delimiter
+constexpr uint8_t SCRAMBLE_OFFSET = 0x33;     // Added to every data field byte on the wire
+constexpr size_t FRAME_ADDRESS_LENGTH = 6;    // BCD address, LSB first
+constexpr size_t FRAME_HEADER_LENGTH = 10;    // start + address + start + control + length
+constexpr size_t FRAME_MAX_DATA_LENGTH = 255; // Length field is one byte
+constexpr size_t FRAME_MAX_LENGTH = FRAME_HEADER_LENGTH + FRAME_MAX_DATA_LENGTH + 2; // + checksum + end
+
+// Modulo-256 sum over [data, data + length), i.e. from the first start delimiter
+// through the last data byte. Preamble bytes are never included.
+uint8_t checksum(const uint8_t* data, size_t length);
+
+// Data field scrambling: +0x33 per byte on transmit, -0x33 on receive
+// (Protocol Section 7.1.6.1)
+void scramble(std::vector<uint8_t>& data);
+void unscramble(std::vector<uint8_t>& data);
+
+// BCD to float conversion (LSB-first byte order). Returns 0.0f on an invalid BCD
+// digit; when `invalid` is non-null it is set accordingly so callers can log.
+float bcd_to_float(const std::vector<uint8_t>& bcd_data, int decimal_places, bool* invalid = nullptr);
+
+// Same, honouring the sign bit in the highest bit of the last byte
+float bcd_to_float_with_sign(const std::vector<uint8_t>& bcd_data, int decimal_places, bool* invalid = nullptr);
+
+// Allocation-free frame builders: format directly into a caller-provided buffer
+// and return the frame length in bytes, or 0 if the buffer is too small. These
+// are the core implementations; the std::vector overloads below wrap them with
+// a single exact-size allocation for callers that want an owned frame.
+
+// Read data command frame (control code 0x11) with a 2-byte preamble. Address
+// is 6 bytes BCD LSB first; the data identifier is scrambled into the data
+// field. See DL/T 645-2007 Section 7.1 for the frame layout.
+size_t build_read_frame(const uint8_t* address, size_t address_length, uint32_t data_identifier, uint8_t* out,
+                        size_t capacity);
+
+// Generic write data command frame (control code 0x14) with a 4-byte preamble.
+// write_data is taken raw and scrambled into the output.
+size_t build_write_frame(const uint8_t* address, size_t address_length, uint32_t data_identifier,
+                         const uint8_t* write_data, size_t data_length, uint8_t* out, size_t capacity);
+
+// Owned-frame conveniences over the buffer builders above
+std::vector<uint8_t> build_read_frame(const std::vector<uint8_t>& address, uint32_t data_identifier);
+std::vector<uint8_t> build_write_frame(const std::vector<uint8_t>& address, uint32_t data_identifier,
+                                       const std::vector<uint8_t>& write_data);
+
+// Structural parse result. Policy decisions (error-reply control codes, passive
+// skipping, address learning) stay with the caller; the codec only validates the
+// wire format.
+enum class ParseResult : uint8_t
+{
+    OK = 0,           // Frame valid, `out` filled, `consumed` covers preamble + frame
+    NEED_MORE_DATA,   // Prefix is consistent but the frame is not complete yet
+    BAD_START,        // First byte after preamble is not 0x68
+    BAD_SECOND_START, // Byte 7 is not 0x68
+    BAD_END,          // End delimiter is not 0x16
+    BAD_CHECKSUM,     // Checksum mismatch
+};
+
+struct ParsedFrame
+{
+    uint8_t address[FRAME_ADDRESS_LENGTH]{}; // BCD, LSB first, as received
+    uint8_t control_code{0};
+    std::vector<uint8_t> data; // Data field, already unscrambled (-0x33)
+};
+
+// Validate and extract one frame from buf[0..length). Leading 0xFE preamble
+// bytes are skipped. On OK, `consumed` is the number of input bytes covered by
+// the preamble plus the frame, so callers can drop exactly that much from their
+// receive buffer and keep any trailing bytes.
+ParseResult parse_frame(const uint8_t* buf, size_t length, ParsedFrame& out, size_t& consumed);
+
+} // namespace codec
+} // namespace dlt645_component
+} // namespace esphome
@@ -0,0 +1,105 @@
+"""
+Native sensor platform for the DLT645 component.
+Channels map straight from the component's cached-value store to sensor entities,
+and publishes are batched: one main-loop pass per event drain publishes every
+channel that changed, instead of one trigger-lambda publish per channel.
+"""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_ENERGY,
+    DEVICE_CLASS_FREQUENCY,
+    DEVICE_CLASS_POWER,
+    DEVICE_CLASS_POWER_FACTOR,
+    DEVICE_CLASS_VOLTAGE,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_AMPERE,
+    UNIT_HERTZ,
+    UNIT_KILOWATT_HOURS,
+    UNIT_VOLT,
+    UNIT_WATT,
+)
+
+from . import DLT645Component
+
+CONF_DLT645_COMPONENT_ID = "dlt645_component_id"
+
+CONF_ACTIVE_POWER = "active_power"
+CONF_ENERGY_ACTIVE = "energy_active"
+CONF_VOLTAGE_A = "voltage_a"
+CONF_CURRENT_A = "current_a"
+CONF_POWER_FACTOR = "power_factor"
+CONF_FREQUENCY = "frequency"
+CONF_ENERGY_REVERSE = "energy_reverse"
+
+# Channel key -> component setter; keys match the hub's `channels:` names, and the
+# setters follow the channel compile-out (a sensor for an undeclared channel fails
+# the C++ build rather than silently never publishing)
+SENSOR_SETTERS = {
+    CONF_ACTIVE_POWER: "set_active_power_sensor",
+    CONF_ENERGY_ACTIVE: "set_energy_active_sensor",
+    CONF_VOLTAGE_A: "set_voltage_a_sensor",
+    CONF_CURRENT_A: "set_current_a_sensor",
+    CONF_POWER_FACTOR: "set_power_factor_sensor",
+    CONF_FREQUENCY: "set_frequency_sensor",
+    CONF_ENERGY_REVERSE: "set_energy_reverse_sensor",
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_DLT645_COMPONENT_ID): cv.use_id(DLT645Component),
+        cv.Optional(CONF_ACTIVE_POWER): sensor.sensor_schema(
+            unit_of_measurement=UNIT_WATT,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_POWER,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_ENERGY_ACTIVE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_KILOWATT_HOURS,
+            accuracy_decimals=2,
+            device_class=DEVICE_CLASS_ENERGY,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+        ),
+        cv.Optional(CONF_VOLTAGE_A): sensor.sensor_schema(
+            unit_of_measurement=UNIT_VOLT,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_VOLTAGE,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_CURRENT_A): sensor.sensor_schema(
+            unit_of_measurement=UNIT_AMPERE,
+            accuracy_decimals=3,
+            device_class=DEVICE_CLASS_CURRENT,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_POWER_FACTOR): sensor.sensor_schema(
+            accuracy_decimals=3,
+            device_class=DEVICE_CLASS_POWER_FACTOR,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_FREQUENCY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_HERTZ,
+            accuracy_decimals=2,
+            device_class=DEVICE_CLASS_FREQUENCY,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_ENERGY_REVERSE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_KILOWATT_HOURS,
+            accuracy_decimals=2,
+            device_class=DEVICE_CLASS_ENERGY,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_DLT645_COMPONENT_ID])
+    for key, setter in SENSOR_SETTERS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(parent, setter)(sens))
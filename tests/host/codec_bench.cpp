@@ -0,0 +1,367 @@
+// Host-native test and benchmark harness for the DL/T 645 frame codec.
+//
+// The whole file is guarded by DLT645_CODEC_HOST_HARNESS (defined by the
+// Makefile next to it) so that ESPHome's source-tree copy, which compiles every
+// .cpp it finds in the component, turns this translation unit into a no-op on
+// target builds.
+#ifdef DLT645_CODEC_HOST_HARNESS
+
+#include "dlt645_codec.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace esphome::dlt645_component::codec;
+
+// ---------------------------------------------------------------------------
+// Allocation accounting: count every operator new so the benchmark can report
+// allocations per parsed frame.
+// ---------------------------------------------------------------------------
+static size_t g_alloc_count = 0;
+
+void* operator new(size_t size)
+{
+    g_alloc_count++;
+    return malloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+// ---------------------------------------------------------------------------
+// Deterministic PRNG (xorshift32) so fuzz runs are reproducible from a seed
+// ---------------------------------------------------------------------------
+static uint32_t g_rng_state = 0x645645u;
+
+static uint32_t rng_next()
+{
+    uint32_t x = g_rng_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_rng_state = x;
+    return x;
+}
+
+// ---------------------------------------------------------------------------
+// Corpus: representative response frames built the same way a meter would
+// answer, plus malformed variants
+// ---------------------------------------------------------------------------
+static const std::vector<uint8_t> METER_ADDRESS = {0x12, 0x90, 0x78, 0x56, 0x34, 0x12};
+
+// Build a response frame (control 0x91) carrying a DI plus BCD payload
+static std::vector<uint8_t> build_response_frame(uint32_t data_identifier, const std::vector<uint8_t>& payload)
+{
+    std::vector<uint8_t> frame;
+    frame.push_back(FRAME_PREAMBLE);
+    frame.push_back(FRAME_PREAMBLE);
+    frame.push_back(FRAME_START);
+    for (size_t i = 0; i < FRAME_ADDRESS_LENGTH; i++) {
+        frame.push_back(METER_ADDRESS[i]);
+    }
+    frame.push_back(FRAME_START);
+    frame.push_back(0x91); // Read data response
+    frame.push_back(static_cast<uint8_t>(4 + payload.size()));
+    frame.push_back(((data_identifier) & 0xFF) + SCRAMBLE_OFFSET);
+    frame.push_back(((data_identifier >> 8) & 0xFF) + SCRAMBLE_OFFSET);
+    frame.push_back(((data_identifier >> 16) & 0xFF) + SCRAMBLE_OFFSET);
+    frame.push_back(((data_identifier >> 24) & 0xFF) + SCRAMBLE_OFFSET);
+    for (size_t i = 0; i < payload.size(); i++) {
+        frame.push_back(payload[i] + SCRAMBLE_OFFSET);
+    }
+    frame.push_back(checksum(frame.data() + 2, frame.size() - 2));
+    frame.push_back(FRAME_END);
+    return frame;
+}
+
+static std::vector<std::vector<uint8_t>> build_corpus()
+{
+    std::vector<std::vector<uint8_t>> corpus;
+
+    // Valid responses for the channels the component polls
+    corpus.push_back(build_response_frame(0x02030000, {0x50, 0x23, 0x01}));       // Active power 1.2350 kW
+    corpus.push_back(build_response_frame(0x00010000, {0x78, 0x56, 0x34, 0x12})); // Energy 123456.78 kWh
+    corpus.push_back(build_response_frame(0x02010100, {0x05, 0x22}));             // Voltage 220.5 V
+    corpus.push_back(build_response_frame(0x02020100, {0x21, 0x54, 0x00}));       // Current 5.421 A
+    corpus.push_back(build_response_frame(0x02060000, {0x87, 0x09}));             // Power factor 0.987
+    corpus.push_back(build_response_frame(0x02800002, {0x02, 0x50}));             // Frequency 50.02 Hz
+    corpus.push_back(build_response_frame(0x00020000, {0x10, 0x00, 0x00, 0x00})); // Reverse energy 0.10 kWh
+
+    // Malformed variants: truncated, corrupted checksum, wrong delimiters, noise
+    std::vector<uint8_t> truncated = corpus[0];
+    truncated.resize(truncated.size() / 2);
+    corpus.push_back(truncated);
+
+    std::vector<uint8_t> bad_checksum = corpus[1];
+    bad_checksum[bad_checksum.size() - 2] ^= 0xFF;
+    corpus.push_back(bad_checksum);
+
+    std::vector<uint8_t> bad_end = corpus[2];
+    bad_end.back() = 0x00;
+    corpus.push_back(bad_end);
+
+    std::vector<uint8_t> bad_second_start = corpus[3];
+    bad_second_start[9] = 0x55; // byte 7 of the frame body (after 2 preamble bytes)
+    corpus.push_back(bad_second_start);
+
+    corpus.push_back({0x00, 0xFF, 0x55, 0xAA, 0x16}); // Line noise, no frame at all
+
+    return corpus;
+}
+
+// ---------------------------------------------------------------------------
+// Self-tests
+// ---------------------------------------------------------------------------
+static int g_failures = 0;
+
+#define CHECK(cond)                                                                                                    \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                                            \
+            g_failures++;                                                                                              \
+        }                                                                                                              \
+    } while (0)
+
+static bool nearly_equal(float a, float b)
+{
+    float diff = a - b;
+    if (diff < 0) {
+        diff = -diff;
+    }
+    return diff < 1e-4f;
+}
+
+static void run_selftest()
+{
+    // Checksum: modulo-256 sum
+    {
+        const uint8_t data[] = {0x68, 0xFF, 0xFF, 0x02};
+        CHECK(checksum(data, 4) == (uint8_t)(0x68 + 0xFF + 0xFF + 0x02));
+    }
+
+    // Scramble round trip
+    {
+        std::vector<uint8_t> data = {0x00, 0x33, 0xCD, 0xFF};
+        std::vector<uint8_t> original = data;
+        scramble(data);
+        CHECK(data[0] == 0x33);
+        unscramble(data);
+        CHECK(data == original);
+    }
+
+    // BCD conversion
+    {
+        bool invalid = false;
+        CHECK(nearly_equal(bcd_to_float({0x50, 0x23, 0x01}, 4, &invalid), 1.2350f));
+        CHECK(!invalid);
+        CHECK(nearly_equal(bcd_to_float({0x78, 0x56, 0x34, 0x12}, 2, &invalid), 123456.78f));
+        CHECK(!invalid);
+        CHECK(bcd_to_float({0x5A}, 0, &invalid) == 0.0f); // 'A' nibble is not BCD
+        CHECK(invalid);
+        // Sign bit in the highest bit of the last byte
+        CHECK(nearly_equal(bcd_to_float_with_sign({0x50, 0x23, 0x81}, 4, &invalid), -1.2350f));
+        CHECK(!invalid);
+        CHECK(nearly_equal(bcd_to_float_with_sign({0x50, 0x23, 0x01}, 4, &invalid), 1.2350f));
+    }
+
+    // Read frame build and structural layout
+    {
+        std::vector<uint8_t> frame = build_read_frame(METER_ADDRESS, 0x02030000);
+        CHECK(frame.size() == 2 + FRAME_HEADER_LENGTH + 4 + 2);
+        CHECK(frame[0] == FRAME_PREAMBLE && frame[1] == FRAME_PREAMBLE);
+        CHECK(frame[2] == FRAME_START && frame[9] == FRAME_START);
+        CHECK(frame[10] == 0x11 && frame[11] == 0x04);
+        CHECK(frame.back() == FRAME_END);
+        CHECK(frame[frame.size() - 2] == checksum(frame.data() + 2, frame.size() - 4));
+
+        // Allocation-free builder produces identical bytes and honours capacity
+        uint8_t buf[64];
+        size_t length = build_read_frame(METER_ADDRESS.data(), METER_ADDRESS.size(), 0x02030000, buf, sizeof(buf));
+        CHECK(length == frame.size());
+        CHECK(memcmp(buf, frame.data(), frame.size()) == 0);
+        CHECK(build_read_frame(METER_ADDRESS.data(), METER_ADDRESS.size(), 0x02030000, buf, 4) == 0);
+    }
+
+    // Allocation-free write builder matches the vector overload
+    {
+        std::vector<uint8_t> payload = {0x19, 0x0A, 0x0A, 0x0F};
+        std::vector<uint8_t> frame = build_write_frame(METER_ADDRESS, 0x04000101, payload);
+        uint8_t buf[64];
+        size_t length = build_write_frame(METER_ADDRESS.data(), METER_ADDRESS.size(), 0x04000101, payload.data(),
+                                          payload.size(), buf, sizeof(buf));
+        CHECK(length == frame.size());
+        CHECK(memcmp(buf, frame.data(), frame.size()) == 0);
+        CHECK(build_write_frame(METER_ADDRESS.data(), METER_ADDRESS.size(), 0x04000101, payload.data(), payload.size(),
+                                buf, 8) == 0);
+    }
+
+    // Write frame round trip through the parser
+    {
+        std::vector<uint8_t> payload = {0x19, 0x0A, 0x0A, 0x0F};
+        std::vector<uint8_t> frame = build_write_frame(METER_ADDRESS, 0x04000101, payload);
+        ParsedFrame parsed;
+        size_t consumed = 0;
+        CHECK(parse_frame(frame.data(), frame.size(), parsed, consumed) == ParseResult::OK);
+        CHECK(consumed == frame.size());
+        CHECK(parsed.control_code == 0x14);
+        CHECK(memcmp(parsed.address, METER_ADDRESS.data(), FRAME_ADDRESS_LENGTH) == 0);
+        CHECK(parsed.data.size() == 4 + payload.size());
+        uint32_t di = parsed.data[0] | (parsed.data[1] << 8) | (parsed.data[2] << 16) | (parsed.data[3] << 24);
+        CHECK(di == 0x04000101);
+        CHECK(memcmp(parsed.data.data() + 4, payload.data(), payload.size()) == 0);
+    }
+
+    // Response frame parse, including trailing bytes staying unconsumed
+    {
+        std::vector<uint8_t> frame = build_response_frame(0x02030000, {0x50, 0x23, 0x01});
+        std::vector<uint8_t> stream = frame;
+        stream.push_back(0xFE); // Next frame's preamble already in the buffer
+        ParsedFrame parsed;
+        size_t consumed = 0;
+        CHECK(parse_frame(stream.data(), stream.size(), parsed, consumed) == ParseResult::OK);
+        CHECK(consumed == frame.size());
+        CHECK(parsed.control_code == 0x91);
+    }
+
+    // Malformed frames
+    {
+        ParsedFrame parsed;
+        size_t consumed = 0;
+        std::vector<uint8_t> frame = build_response_frame(0x02030000, {0x50, 0x23, 0x01});
+
+        CHECK(parse_frame(frame.data(), 5, parsed, consumed) == ParseResult::NEED_MORE_DATA);
+        CHECK(parse_frame(frame.data(), frame.size() - 1, parsed, consumed) == ParseResult::NEED_MORE_DATA);
+
+        std::vector<uint8_t> corrupt = frame;
+        corrupt[corrupt.size() - 2] ^= 0x01;
+        CHECK(parse_frame(corrupt.data(), corrupt.size(), parsed, consumed) == ParseResult::BAD_CHECKSUM);
+
+        corrupt = frame;
+        corrupt.back() = 0x00;
+        CHECK(parse_frame(corrupt.data(), corrupt.size(), parsed, consumed) == ParseResult::BAD_END);
+
+        corrupt = frame;
+        corrupt[2] = 0x42; // First byte after preamble
+        CHECK(parse_frame(corrupt.data(), corrupt.size(), parsed, consumed) == ParseResult::BAD_START);
+
+        corrupt = frame;
+        corrupt[9] = 0x42; // Second start delimiter
+        CHECK(parse_frame(corrupt.data(), corrupt.size(), parsed, consumed) == ParseResult::BAD_SECOND_START);
+
+        std::vector<uint8_t> only_preamble = {0xFE, 0xFE, 0xFE};
+        CHECK(parse_frame(only_preamble.data(), only_preamble.size(), parsed, consumed) == ParseResult::NEED_MORE_DATA);
+    }
+
+    if (g_failures == 0) {
+        printf("selftest: all checks passed\n");
+    } else {
+        printf("selftest: %d check(s) FAILED\n", g_failures);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: replay the corpus and report frames/sec and allocations per frame
+// ---------------------------------------------------------------------------
+static void run_bench()
+{
+    const std::vector<std::vector<uint8_t>> corpus = build_corpus();
+    const size_t iterations = 2000000;
+
+    ParsedFrame parsed;
+    size_t consumed = 0;
+    size_t parsed_ok = 0;
+
+    g_alloc_count = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        const std::vector<uint8_t>& frame = corpus[i % corpus.size()];
+        if (parse_frame(frame.data(), frame.size(), parsed, consumed) == ParseResult::OK) {
+            parsed_ok++;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    size_t allocs = g_alloc_count;
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("bench: %zu frames in %.3fs (%.0f frames/sec), %zu ok\n", iterations, seconds, iterations / seconds,
+           parsed_ok);
+    printf("bench: %zu allocations total, %.3f per frame\n", allocs, (double)allocs / iterations);
+}
+
+// ---------------------------------------------------------------------------
+// Fuzz: random noise and random mutations of valid frames through the parser.
+// The parser must never crash and must never accept a frame whose checksum or
+// delimiters were mutated into inconsistency without detecting it structurally.
+// ---------------------------------------------------------------------------
+static void run_fuzz(uint32_t seed)
+{
+    g_rng_state = seed;
+    const std::vector<std::vector<uint8_t>> corpus = build_corpus();
+    const size_t iterations = 5000000;
+
+    ParsedFrame parsed;
+    size_t consumed = 0;
+    size_t accepted = 0;
+
+    std::vector<uint8_t> buf;
+    for (size_t i = 0; i < iterations; i++) {
+        if ((rng_next() & 1) == 0) {
+            // Pure random noise
+            buf.resize(rng_next() % 64);
+            for (size_t j = 0; j < buf.size(); j++) {
+                buf[j] = rng_next() & 0xFF;
+            }
+        } else {
+            // Mutated valid frame: flip a few random bytes
+            buf = corpus[rng_next() % corpus.size()];
+            size_t flips = 1 + (rng_next() % 3);
+            for (size_t f = 0; f < flips && !buf.empty(); f++) {
+                buf[rng_next() % buf.size()] ^= 1 << (rng_next() % 8);
+            }
+        }
+
+        ParseResult result = parse_frame(buf.data(), buf.size(), parsed, consumed);
+        if (result == ParseResult::OK) {
+            accepted++;
+            CHECK(consumed <= buf.size());
+        }
+    }
+
+    printf("fuzz: %zu inputs, %zu structurally valid, seed 0x%08X, %s\n", iterations, accepted, seed,
+           g_failures == 0 ? "no parser violations" : "VIOLATIONS FOUND");
+}
+
+int main(int argc, char** argv)
+{
+    std::string mode = argc > 1 ? argv[1] : "--selftest";
+
+    if (mode == "--selftest") {
+        run_selftest();
+    } else if (mode == "--bench") {
+        run_bench();
+    } else if (mode == "--fuzz") {
+        uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 0) : 0x645645u;
+        run_fuzz(seed);
+    } else {
+        fprintf(stderr, "usage: %s [--selftest|--bench|--fuzz [seed]]\n", argv[0]);
+        return 2;
+    }
+
+    return g_failures == 0 ? 0 : 1;
+}
+
+#endif // DLT645_CODEC_HOST_HARNESS
@@ -0,0 +1,224 @@
+// Host-native replay tool for flight recorder dumps.
+//
+// `dlt645_component.dump_flight_recorder` prints one line per captured bus
+// event in the form
+//
+//     FR <index> <timestamp_ms> <TX|RX> <hex bytes>
+//
+// (usually wrapped in the ESP_LOG prefix). This tool scans a captured log for
+// those lines, runs every RX byte back through the exact parser the firmware
+// uses, and reports parse outcomes plus TX-to-first-response latency — so a
+// misbehaving meter or timing problem can be analysed offline from a single
+// serial log, without re-flashing instrumented builds.
+//
+// Guarded by DLT645_CODEC_HOST_HARNESS for the same reason as codec_bench.cpp:
+// ESPHome compiles every .cpp it finds in the component tree.
+#ifdef DLT645_CODEC_HOST_HARNESS
+
+#include "dlt645_codec.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace esphome::dlt645_component::codec;
+
+struct FlightRecord {
+    uint32_t index;
+    uint32_t timestamp_ms;
+    bool tx;
+    std::vector<uint8_t> bytes;
+};
+
+// Parse one dump line. Returns false if the line carries no FR record. The
+// "FR " marker may appear anywhere in the line so logger prefixes and
+// timestamps added by the capture terminal are ignored.
+static bool parse_fr_line(const std::string& line, FlightRecord& record)
+{
+    size_t marker = line.find("FR ");
+    if (marker == std::string::npos) {
+        return false;
+    }
+    // Avoid false positives mid-word ("...BUFFER ...")
+    if (marker > 0 && line[marker - 1] != ' ' && line[marker - 1] != ':' && line[marker - 1] != '\t') {
+        return false;
+    }
+
+    const char* cursor = line.c_str() + marker + 3;
+    char direction[4] = {0};
+    int consumed_chars = 0;
+    if (sscanf(cursor, "%u %u %3s %n", &record.index, &record.timestamp_ms, direction, &consumed_chars) < 3) {
+        return false;
+    }
+    if (strcmp(direction, "TX") == 0) {
+        record.tx = true;
+    } else if (strcmp(direction, "RX") == 0) {
+        record.tx = false;
+    } else {
+        return false;
+    }
+
+    record.bytes.clear();
+    cursor += consumed_chars;
+    unsigned value = 0;
+    int advance = 0;
+    while (sscanf(cursor, "%2x%n", &value, &advance) == 1) {
+        record.bytes.push_back(static_cast<uint8_t>(value));
+        cursor += advance;
+        while (*cursor == ' ') {
+            cursor++;
+        }
+    }
+    return !record.bytes.empty();
+}
+
+static const char* parse_result_name(ParseResult result)
+{
+    switch (result) {
+        case ParseResult::OK:
+            return "OK";
+        case ParseResult::NEED_MORE_DATA:
+            return "NEED_MORE_DATA";
+        case ParseResult::BAD_START:
+            return "BAD_START";
+        case ParseResult::BAD_SECOND_START:
+            return "BAD_SECOND_START";
+        case ParseResult::BAD_END:
+            return "BAD_END";
+        case ParseResult::BAD_CHECKSUM:
+            return "BAD_CHECKSUM";
+    }
+    return "?";
+}
+
+int main(int argc, char** argv)
+{
+    bool verbose = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (path == nullptr) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [-v] <dump-log-file | - for stdin>\n", argv[0]);
+            return 2;
+        }
+    }
+    if (path == nullptr) {
+        fprintf(stderr, "usage: %s [-v] <dump-log-file | - for stdin>\n", argv[0]);
+        return 2;
+    }
+
+    FILE* input = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (input == nullptr) {
+        fprintf(stderr, "flight_replay: cannot open %s\n", path);
+        return 2;
+    }
+
+    // Replay state: RX chunks are appended to a stream buffer and parsed with
+    // the same consumed-byte accounting the firmware's ring drain uses, so
+    // frames split across chunk records reassemble exactly as they did live.
+    std::vector<uint8_t> rx_stream;
+    ParsedFrame parsed;
+    size_t consumed = 0;
+
+    size_t records = 0, tx_records = 0, rx_records = 0;
+    size_t tx_bytes = 0, rx_bytes = 0;
+    size_t frames_ok = 0, frames_bad = 0;
+
+    // TX-to-first-RX latency: timestamp of the last TX still awaiting a reply
+    bool awaiting_reply = false;
+    uint32_t last_tx_ms = 0;
+    uint32_t latency_min = 0, latency_max = 0;
+    uint64_t latency_sum = 0;
+    size_t latency_samples = 0;
+
+    uint32_t first_ms = 0, last_ms = 0;
+
+    char line_buf[1024];
+    FlightRecord record;
+    while (fgets(line_buf, sizeof(line_buf), input) != nullptr) {
+        if (!parse_fr_line(line_buf, record)) {
+            continue;
+        }
+        records++;
+        if (records == 1) {
+            first_ms = record.timestamp_ms;
+        }
+        last_ms = record.timestamp_ms;
+
+        if (record.tx) {
+            tx_records++;
+            tx_bytes += record.bytes.size();
+            // A fresh request invalidates any partial response still buffered
+            rx_stream.clear();
+            awaiting_reply = true;
+            last_tx_ms = record.timestamp_ms;
+            if (verbose) {
+                printf("%8u ms  TX %zu bytes\n", record.timestamp_ms, record.bytes.size());
+            }
+            continue;
+        }
+
+        rx_records++;
+        rx_bytes += record.bytes.size();
+        if (awaiting_reply) {
+            uint32_t latency = record.timestamp_ms - last_tx_ms;
+            if (latency_samples == 0 || latency < latency_min) {
+                latency_min = latency;
+            }
+            if (latency > latency_max) {
+                latency_max = latency;
+            }
+            latency_sum += latency;
+            latency_samples++;
+            awaiting_reply = false;
+        }
+
+        rx_stream.insert(rx_stream.end(), record.bytes.begin(), record.bytes.end());
+        while (!rx_stream.empty()) {
+            ParseResult result = parse_frame(rx_stream.data(), rx_stream.size(), parsed, consumed);
+            if (result == ParseResult::NEED_MORE_DATA) {
+                break;
+            }
+            if (result == ParseResult::OK) {
+                frames_ok++;
+                if (verbose) {
+                    printf("%8u ms  RX frame OK: control 0x%02X, %zu data bytes\n", record.timestamp_ms,
+                           parsed.control_code, parsed.data.size());
+                }
+                rx_stream.erase(rx_stream.begin(), rx_stream.begin() + consumed);
+            } else {
+                frames_bad++;
+                printf("%8u ms  RX parse %s (%zu bytes buffered)\n", record.timestamp_ms, parse_result_name(result),
+                       rx_stream.size());
+                // Resynchronize the same way the firmware does: drop one byte
+                rx_stream.erase(rx_stream.begin());
+            }
+        }
+    }
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    if (records == 0) {
+        fprintf(stderr, "flight_replay: no FR records found in %s\n", path);
+        return 1;
+    }
+
+    printf("replay: %zu records (%zu TX / %zu RX), %zu TX bytes, %zu RX bytes, %u ms span\n", records, tx_records,
+           rx_records, tx_bytes, rx_bytes, last_ms - first_ms);
+    printf("replay: %zu frames parsed OK, %zu parse errors, %zu bytes left unparsed\n", frames_ok, frames_bad,
+           rx_stream.size());
+    if (latency_samples > 0) {
+        printf("replay: TX->first-RX latency min/avg/max %u/%.1f/%u ms over %zu exchanges\n", latency_min,
+               (double)latency_sum / latency_samples, latency_max, latency_samples);
+    }
+
+    return frames_bad == 0 ? 0 : 1;
+}
+
+#endif // DLT645_CODEC_HOST_HARNESS
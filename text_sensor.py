@@ -0,0 +1,37 @@
+"""
+Native text sensor platform for the DLT645 component.
+The date and time channels publish as formatted strings through the same batched
+main-loop pass as the numeric sensor platform (see publish_batched_sensors_).
+"""
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import text_sensor
+
+from . import DLT645Component
+
+CONF_DLT645_COMPONENT_ID = "dlt645_component_id"
+
+CONF_DATETIME = "datetime"
+CONF_TIME_HMS = "time_hms"
+
+TEXT_SENSOR_SETTERS = {
+    CONF_DATETIME: "set_datetime_text_sensor",
+    CONF_TIME_HMS: "set_time_hms_text_sensor",
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_DLT645_COMPONENT_ID): cv.use_id(DLT645Component),
+        cv.Optional(CONF_DATETIME): text_sensor.text_sensor_schema(),
+        cv.Optional(CONF_TIME_HMS): text_sensor.text_sensor_schema(),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_DLT645_COMPONENT_ID])
+    for key, setter in TEXT_SENSOR_SETTERS.items():
+        if key in config:
+            sens = await text_sensor.new_text_sensor(config[key])
+            cg.add(getattr(parent, setter)(sens))